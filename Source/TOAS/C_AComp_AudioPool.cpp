@@ -0,0 +1,53 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_AComp_AudioPool.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+
+// Sets default values for this component's properties
+UC_AComp_AudioPool::UC_AComp_AudioPool()
+{
+	// This component does not need to Tick; sounds are played when requested.
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UC_AComp_AudioPool::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Every Audio Component is created up front, so playing a sound never allocates.
+	AudioComponents.Reserve(PoolSize);
+	for (int32 Index = 0; Index < PoolSize; ++Index)
+	{
+		UAudioComponent* AudioComponent = NewObject<UAudioComponent>(GetOwner());
+		AudioComponent->bAutoActivate = false;
+		AudioComponent->bAutoDestroy = false;
+		AudioComponent->RegisterComponent();
+		AudioComponents.Add(AudioComponent);
+	}
+}
+
+void UC_AComp_AudioPool::PlaySoundAtLocation(USoundBase* Sound, const FVector& Location,
+	const float VolumeMultiplier)
+{
+	if (Sound == nullptr || AudioComponents.Num() == 0)
+	{
+		return;
+	}
+
+	// Components are used in turns, so the next one is always the one that started playing the longest ago.
+	UAudioComponent* AudioComponent = AudioComponents[NextComponent];
+	NextComponent = (NextComponent + 1) % AudioComponents.Num();
+
+	if (AudioComponent->Sound != Sound)
+	{
+		AudioComponent->SetSound(Sound);
+	}
+
+	AudioComponent->SetWorldLocation(Location);
+	AudioComponent->SetVolumeMultiplier(VolumeMultiplier);
+	AudioComponent->Play();
+}
@@ -0,0 +1,52 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "C_AComp_AudioPool.generated.h"
+
+class UAudioComponent;
+class USoundBase;
+
+/**
+ * Actor Component that owns a small pool of Audio Components, created once when the game starts,
+ * and plays short one-shot sounds (like footsteps) through them instead of spawning a new component per sound.
+ * When every component is busy, the one that started playing the longest ago is reused.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class TOAS_API UC_AComp_AudioPool : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this component's properties
+	UC_AComp_AudioPool();
+
+	/**
+	 * Plays a sound at a world location through one of the pooled Audio Components.
+	 * @param Sound Sound to play; nothing happens if it's null.
+	 * @param Location World Location where the sound is played.
+	 * @param VolumeMultiplier Multiplier applied to the sound's volume.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio_Pool")
+	void PlaySoundAtLocation(USoundBase* Sound, const FVector& Location, const float VolumeMultiplier = 1.0f);
+
+protected:
+	// Called when the game starts
+	virtual void BeginPlay() override;
+
+	// Amount of Audio Components in the pool; also the amount of sounds that can overlap.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio_Pool", meta = (AllowPrivateAccess = "true"))
+	int32 PoolSize = 4;
+
+private:
+	// Pooled Audio Components.
+	UPROPERTY()
+	TArray<UAudioComponent*> AudioComponents;
+
+	// Index of the next component to use; also the one that started playing the longest ago.
+	int32 NextComponent = 0;
+};
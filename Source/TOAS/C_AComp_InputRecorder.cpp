@@ -0,0 +1,378 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_AComp_InputRecorder.h"
+#include "EnhancedInputComponent.h"
+#include "EnhancedInputSubsystems.h"
+#include "InputAction.h"
+#include "InputMappingContext.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace InputRecording
+{
+	// Identifies the files written by the Input Recorder ("TOIR").
+	constexpr uint32 Magic = 0x52494F54;
+
+	// Increased every time the layout of the file changes.
+	constexpr uint16 Version = 2;
+}
+
+// Sets default values for this component's properties
+UC_AComp_InputRecorder::UC_AComp_InputRecorder()
+{
+	// Ticks only while recording or replaying.
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UC_AComp_InputRecorder::BindActions(UEnhancedInputComponent* InputComponent,
+	const TArray<UInputAction*>& OwnerActions, UInputMappingContext* InMappingContext)
+{
+	if (InputComponent == nullptr)
+	{
+		return;
+	}
+
+	BoundInputComponent = InputComponent;
+	MappingContext = InMappingContext;
+
+	for (UInputAction* Action : OwnerActions)
+	{
+		RecordedActions.AddUnique(Action);
+	}
+
+	// The Mapping Context is removed during playback, so every action it maps has to be replayed.
+	if (MappingContext != nullptr)
+	{
+		for (const FEnhancedActionKeyMapping& Mapping : MappingContext->GetMappings())
+		{
+			RecordedActions.AddUnique(const_cast<UInputAction*>(Mapping.Action.Get()));
+		}
+	}
+	RecordedActions.Remove(nullptr);
+
+	// Value bindings keep track of each action's value without affecting how the owner handles it.
+	for (const UInputAction* Action : RecordedActions)
+	{
+		InputComponent->BindActionValue(Action);
+	}
+
+	LastValues.Init(FVector::ZeroVector, RecordedActions.Num());
+
+	StartFromCommandLine();
+}
+
+void UC_AComp_InputRecorder::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// The owner may bind its actions before or after beginning play; whichever comes last starts the run.
+	StartFromCommandLine();
+}
+
+void UC_AComp_InputRecorder::StartFromCommandLine()
+{
+	if (bCommandLineHandled == true || HasBegunPlay() == false || BoundInputComponent.IsValid() == false)
+	{
+		return;
+	}
+	bCommandLineHandled = true;
+
+	// Runs used for performance captures are started from the command line.
+	FString RecordingName;
+	if (FParse::Value(FCommandLine::Get(), TEXT("RecordInput="), RecordingName))
+	{
+		StartRecording(RecordingName);
+	}
+	else if (FParse::Value(FCommandLine::Get(), TEXT("ReplayInput="), RecordingName))
+	{
+		StartPlayback(RecordingName);
+	}
+}
+
+void UC_AComp_InputRecorder::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (Mode == EInputRecorderMode::RECORDING)
+	{
+		StopRecording();
+	}
+	else if (Mode == EInputRecorderMode::PLAYBACK)
+	{
+		StopPlayback();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UC_AComp_InputRecorder::StartRecording(const FString& RecordingName)
+{
+	if (Mode != EInputRecorderMode::IDLE || BoundInputComponent.IsValid() == false)
+	{
+		return;
+	}
+
+	Mode = EInputRecorderMode::RECORDING;
+	CurrentRecordingName = RecordingName;
+	CurrentFrame = 0;
+	Events.Reset();
+	LastValues.Init(FVector::ZeroVector, RecordedActions.Num());
+
+	BeginFixedTimeStep();
+	WaitForControllerInput();
+	SetComponentTickEnabled(true);
+}
+
+bool UC_AComp_InputRecorder::StopRecording()
+{
+	if (Mode != EInputRecorderMode::RECORDING)
+	{
+		return false;
+	}
+
+	Mode = EInputRecorderMode::IDLE;
+	SetComponentTickEnabled(false);
+	EndFixedTimeStep();
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = InputRecording::Magic;
+	uint16 Version = InputRecording::Version;
+	float DeltaTime = FixedDeltaTime;
+	int32 Seed = RandomSeed;
+	int32 NumActions = RecordedActions.Num();
+	int32 NumEvents = Events.Num();
+	uint32 NumFrames = CurrentFrame;
+	Writer << Magic << Version << DeltaTime << Seed << NumActions << NumEvents << NumFrames;
+
+	// Action names are only written once, so a replay can match them with its own actions.
+	for (const UInputAction* Action : RecordedActions)
+	{
+		FString ActionName = Action->GetName();
+		Writer << ActionName;
+	}
+
+	// Each event takes 17 bytes: frame, action and three axes.
+	for (FInputRecordEvent& Event : Events)
+	{
+		FVector3f Value(Event.Value);
+		Writer << Event.Frame << Event.ActionIndex << Value;
+	}
+
+	return FFileHelper::SaveArrayToFile(Bytes, *GetRecordingPath(CurrentRecordingName));
+}
+
+bool UC_AComp_InputRecorder::StartPlayback(const FString& RecordingName)
+{
+	if (Mode != EInputRecorderMode::IDLE)
+	{
+		return false;
+	}
+
+	TArray<uint8> Bytes;
+	if (FFileHelper::LoadFileToArray(Bytes, *GetRecordingPath(RecordingName)) == false)
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	float DeltaTime = 0.0f;
+	int32 Seed = 0;
+	int32 NumActions = 0;
+	int32 NumEvents = 0;
+	uint32 NumFrames = 0;
+	Reader << Magic << Version << DeltaTime << Seed << NumActions << NumEvents << NumFrames;
+
+	if (Magic != InputRecording::Magic || Version != InputRecording::Version || NumActions < 0 || NumEvents < 0)
+	{
+		return false;
+	}
+
+	// Maps the recorded actions to this component's actions by name; actions that no longer exist are skipped.
+	TArray<int32> ActionRemap;
+	ActionRemap.Reserve(NumActions);
+	for (int32 Index = 0; Index < NumActions; ++Index)
+	{
+		FString ActionName;
+		Reader << ActionName;
+		ActionRemap.Add(RecordedActions.IndexOfByPredicate([&ActionName](const UInputAction* Action)
+		{
+			return Action->GetName() == ActionName;
+		}));
+	}
+
+	Events.Reset(NumEvents);
+	for (int32 Index = 0; Index < NumEvents && Reader.IsError() == false; ++Index)
+	{
+		FInputRecordEvent Event;
+		FVector3f Value;
+		Reader << Event.Frame << Event.ActionIndex << Value;
+
+		if (ActionRemap.IsValidIndex(Event.ActionIndex) && ActionRemap[Event.ActionIndex] != INDEX_NONE)
+		{
+			Event.ActionIndex = ActionRemap[Event.ActionIndex];
+			Event.Value = FVector(Value);
+			Events.Add(Event);
+		}
+	}
+
+	if (Reader.IsError() == true)
+	{
+		Events.Reset();
+		return false;
+	}
+
+	// The replay runs with the same time step and seed it was recorded with.
+	FixedDeltaTime = DeltaTime;
+	RandomSeed = Seed;
+
+	// The player's devices are disconnected from the owner while the replay feeds it.
+	UEnhancedInputLocalPlayerSubsystem* Subsystem = GetInputSubsystem();
+	if (Subsystem != nullptr && MappingContext != nullptr)
+	{
+		Subsystem->RemoveMappingContext(MappingContext);
+	}
+
+	Mode = EInputRecorderMode::PLAYBACK;
+	CurrentFrame = 0;
+	RecordedFrames = NumFrames;
+	NextEvent = 0;
+	LastValues.Init(FVector::ZeroVector, RecordedActions.Num());
+
+	BeginFixedTimeStep();
+	WaitForControllerInput();
+	SetComponentTickEnabled(true);
+	return true;
+}
+
+void UC_AComp_InputRecorder::StopPlayback()
+{
+	if (Mode != EInputRecorderMode::PLAYBACK)
+	{
+		return;
+	}
+
+	Mode = EInputRecorderMode::IDLE;
+	SetComponentTickEnabled(false);
+	EndFixedTimeStep();
+	Events.Reset();
+
+	UEnhancedInputLocalPlayerSubsystem* Subsystem = GetInputSubsystem();
+	if (Subsystem != nullptr && MappingContext != nullptr)
+	{
+		Subsystem->AddMappingContext(MappingContext, 0);
+	}
+
+	OnPlaybackFinished.Broadcast();
+}
+
+void UC_AComp_InputRecorder::TickComponent(float DeltaTime, ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const UEnhancedInputComponent* InputComponent = BoundInputComponent.Get();
+
+	if (Mode == EInputRecorderMode::RECORDING && InputComponent != nullptr)
+	{
+		// Only changes are stored; an action keeps its value until the next event.
+		for (int32 Index = 0; Index < RecordedActions.Num(); ++Index)
+		{
+			const FVector Value = InputComponent->GetBoundActionValue(RecordedActions[Index]).Get<FVector>();
+			if (Value.Equals(LastValues[Index]) == false)
+			{
+				Events.Add({ CurrentFrame, static_cast<uint8>(Index), Value });
+				LastValues[Index] = Value;
+			}
+		}
+	}
+	else if (Mode == EInputRecorderMode::PLAYBACK)
+	{
+		// The replay lasts as long as the recording did, not just until its last change,
+		// and the last recorded frame was already injected on the previous tick.
+		if (CurrentFrame + 1 >= RecordedFrames)
+		{
+			StopPlayback();
+			return;
+		}
+
+		// Injected input is processed on the next frame, which is the one these values were recorded in,
+		// so the events of the next frame are applied now.
+		while (Events.IsValidIndex(NextEvent) && Events[NextEvent].Frame <= CurrentFrame + 1)
+		{
+			LastValues[Events[NextEvent].ActionIndex] = Events[NextEvent].Value;
+			++NextEvent;
+		}
+
+		UEnhancedInputLocalPlayerSubsystem* Subsystem = GetInputSubsystem();
+
+		// Actions are fed every frame they are held, like a device would.
+		for (int32 Index = 0; Subsystem != nullptr && Index < RecordedActions.Num(); ++Index)
+		{
+			if (LastValues[Index].IsZero() == false)
+			{
+				const FInputActionValue Value(RecordedActions[Index]->ValueType, LastValues[Index]);
+				Subsystem->InjectInputForAction(RecordedActions[Index], Value, {}, {});
+			}
+		}
+	}
+
+	++CurrentFrame;
+}
+
+void UC_AComp_InputRecorder::WaitForControllerInput()
+{
+	// Input is read (and injected) after the owner's controller has processed this frame's input.
+	const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+	if (OwnerPawn != nullptr && OwnerPawn->GetController() != nullptr)
+	{
+		AddTickPrerequisiteActor(OwnerPawn->GetController());
+	}
+}
+
+void UC_AComp_InputRecorder::BeginFixedTimeStep()
+{
+	bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+	PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(FixedDeltaTime);
+	FMath::RandInit(RandomSeed);
+	FMath::SRandInit(RandomSeed);
+}
+
+void UC_AComp_InputRecorder::EndFixedTimeStep()
+{
+	FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+}
+
+UEnhancedInputLocalPlayerSubsystem* UC_AComp_InputRecorder::GetInputSubsystem() const
+{
+	const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+	const APlayerController* PlayerController = OwnerPawn != nullptr
+		? Cast<APlayerController>(OwnerPawn->GetController()) : nullptr;
+
+	return PlayerController != nullptr
+		? ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer())
+		: nullptr;
+}
+
+FString UC_AComp_InputRecorder::GetRecordingPath(const FString& RecordingName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("InputRecordings") / (RecordingName + TEXT(".toasinput"));
+}
@@ -0,0 +1,165 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "C_AComp_InputRecorder.generated.h"
+
+class UEnhancedInputComponent;
+class UInputAction;
+class UInputMappingContext;
+class UEnhancedInputLocalPlayerSubsystem;
+
+// What the Input Recorder is currently doing.
+UENUM(BlueprintType)
+enum class EInputRecorderMode : uint8
+{
+	IDLE UMETA(DisplayName="Idle"),
+	RECORDING UMETA(DisplayName="Recording"),
+	PLAYBACK UMETA(DisplayName="Playback")
+};
+
+// Delegation of a replay reaching its last frame.
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FInputPlaybackFinished);
+
+/**
+ * Actor Component that records the values of the owner's Enhanced Input Actions every frame into a compact binary
+ * file, and replays them later by injecting them back, so the same run can be profiled before and after a change.
+ * Both modes run the world with a fixed time step and a fixed random seed, so replays are deterministic.
+ * They can be started from Blueprints or from the command line with -RecordInput=Name or -ReplayInput=Name;
+ * files are kept in Saved/InputRecordings.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class TOAS_API UC_AComp_InputRecorder : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this component's properties
+	UC_AComp_InputRecorder();
+
+	// Delegate called once a replay reaches its last frame.
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FInputPlaybackFinished OnPlaybackFinished;
+
+	/**
+	 * Binds the values of the Input Actions to record; the owner's own actions are added to RecordedActions.
+	 * @param InputComponent Enhanced Input Component of the owner.
+	 * @param OwnerActions Input Actions handled by the owner in C++ (move, look, sprint, jump).
+	 * @param InMappingContext Mapping Context removed during playback, so the devices don't interfere.
+	 * Every action it maps is recorded as well, so actions handled in Blueprints (attacks, dodges) are replayed too.
+	 */
+	void BindActions(UEnhancedInputComponent* InputComponent, const TArray<UInputAction*>& OwnerActions,
+		UInputMappingContext* InMappingContext);
+
+	// Starts recording the input into Saved/InputRecordings/RecordingName.
+	UFUNCTION(BlueprintCallable, Category = "Input_Recorder")
+	void StartRecording(const FString& RecordingName);
+
+	// Stops recording and writes the file. Returns false if it couldn't be written.
+	UFUNCTION(BlueprintCallable, Category = "Input_Recorder")
+	bool StopRecording();
+
+	// Loads Saved/InputRecordings/RecordingName and starts replaying it. Returns false if it couldn't be loaded.
+	UFUNCTION(BlueprintCallable, Category = "Input_Recorder")
+	bool StartPlayback(const FString& RecordingName);
+
+	// Stops replaying and gives control back to the player's devices.
+	UFUNCTION(BlueprintCallable, Category = "Input_Recorder")
+	void StopPlayback();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Input_Recorder")
+	EInputRecorderMode GetMode() const { return Mode; }
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+		FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	// Called when the game starts; starts recording or replaying if asked from the command line.
+	virtual void BeginPlay() override;
+
+	// Called when the component stops playing; writes any recording still in progress.
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Extra Input Actions to record; the ones mapped by the owner's Mapping Context are added on their own.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input_Recorder", meta = (AllowPrivateAccess = "true"))
+	TArray<UInputAction*> RecordedActions;
+
+	// Seconds per frame used while recording and replaying.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input_Recorder", meta = (AllowPrivateAccess = "true"))
+	float FixedDeltaTime = 1.0f / 60.0f;
+
+	// Random seed set when recording and replaying begin.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input_Recorder", meta = (AllowPrivateAccess = "true"))
+	int32 RandomSeed = 1337;
+
+private:
+	// A single change in the value of an Input Action.
+	struct FInputRecordEvent
+	{
+		// Frame, counted from the beginning of the recording, in which the value changed.
+		uint32 Frame = 0;
+
+		// Index of the Input Action in RecordedActions.
+		uint8 ActionIndex = 0;
+
+		// New value of the Input Action; unused axes are 0.
+		FVector Value = FVector::ZeroVector;
+	};
+
+	// Starts recording or replaying if asked from the command line, once the actions are bound and play began.
+	void StartFromCommandLine();
+
+	// Makes this component tick after the owner's controller.
+	void WaitForControllerInput();
+
+	// Makes the world advance by FixedDeltaTime every frame, with a known random seed.
+	void BeginFixedTimeStep();
+
+	// Restores the time step the world had before recording or replaying.
+	void EndFixedTimeStep();
+
+	// Obtains the Enhanced Input subsystem of the player controlling the owner, if any.
+	UEnhancedInputLocalPlayerSubsystem* GetInputSubsystem() const;
+
+	// Obtains the full path of a recording.
+	static FString GetRecordingPath(const FString& RecordingName);
+
+	// Enhanced Input Component holding the value bindings of every recorded Input Action.
+	TWeakObjectPtr<UEnhancedInputComponent> BoundInputComponent;
+
+	// Last value recorded (or replayed) for each Input Action, sharing the indices of RecordedActions.
+	TArray<FVector> LastValues;
+
+	// Changes recorded so far, or loaded for playback, sorted by frame.
+	TArray<FInputRecordEvent> Events;
+
+	// Mapping Context removed during playback.
+	UPROPERTY()
+	UInputMappingContext* MappingContext;
+
+	EInputRecorderMode Mode = EInputRecorderMode::IDLE;
+
+	// Name of the recording in progress.
+	FString CurrentRecordingName;
+
+	// Frames since recording or replaying began.
+	uint32 CurrentFrame = 0;
+
+	// Length of the recording being replayed, in frames.
+	uint32 RecordedFrames = 0;
+
+	// Next event to replay.
+	int32 NextEvent = 0;
+
+	// Whether the command line was already checked for a run to start.
+	bool bCommandLineHandled = false;
+
+	// Time step settings to restore once done.
+	bool bPreviousUseFixedTimeStep = false;
+	double PreviousFixedDeltaTime = 0.0;
+};
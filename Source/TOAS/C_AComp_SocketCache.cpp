@@ -0,0 +1,168 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_AComp_SocketCache.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "GameFramework/Character.h"
+
+// Sets default values for this component's properties
+UC_AComp_SocketCache::UC_AComp_SocketCache()
+{
+	// This component does not need to Tick; transforms are computed when read.
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+int32 UC_AComp_SocketCache::RegisterSocket(const FName& SocketName)
+{
+	// If the socket was already registered, share its handle.
+	if (const int32* ExistingHandle = SocketHandles.Find(SocketName))
+	{
+		return *ExistingHandle;
+	}
+
+	// The mesh may not be known yet if sockets are registered before this component begins play.
+	if (Mesh.IsValid() == false)
+	{
+		if (const ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner()))
+		{
+			Mesh = OwnerCharacter->GetMesh();
+		}
+	}
+
+	FCachedSocket& CachedSocket = Sockets.AddDefaulted_GetRef();
+	CachedSocket.SocketName = SocketName;
+	ResolveSocket(CachedSocket);
+
+	const int32 NewHandle = Sockets.Num() - 1;
+	SocketHandles.Add(SocketName, NewHandle);
+	return NewHandle;
+}
+
+bool UC_AComp_SocketCache::GetSocketTransform(const int32 SocketHandle, FTransform& OutTransform)
+{
+	const USkeletalMeshComponent* MeshComp = Mesh.Get();
+
+	if (Sockets.IsValidIndex(SocketHandle) == false || MeshComp == nullptr)
+	{
+		return false;
+	}
+
+	ResolveAllSocketsIfMeshChanged();
+
+	FCachedSocket& CachedSocket = Sockets[SocketHandle];
+
+	// Same as DoesSocketExist returning false.
+	if (CachedSocket.BoneIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Compute the world transform only once per frame, and once more if the pose got finalized after the last read.
+	if (CachedSocket.CachedFrame != GFrameCounter || CachedSocket.CachedPose != PoseCounter)
+	{
+		CachedSocket.WorldTransform = CachedSocket.LocalTransform * MeshComp->GetBoneTransform(CachedSocket.BoneIndex);
+		CachedSocket.CachedFrame = GFrameCounter;
+		CachedSocket.CachedPose = PoseCounter;
+	}
+
+	OutTransform = CachedSocket.WorldTransform;
+	return true;
+}
+
+bool UC_AComp_SocketCache::GetSocketTransformByName(const FName& SocketName, FTransform& OutTransform)
+{
+	return GetSocketTransform(RegisterSocket(SocketName), OutTransform);
+}
+
+bool UC_AComp_SocketCache::GetSocketLocation(const int32 SocketHandle, FVector& OutLocation)
+{
+	FTransform SocketTransform;
+	if (GetSocketTransform(SocketHandle, SocketTransform) == false)
+	{
+		return false;
+	}
+
+	OutLocation = SocketTransform.GetLocation();
+	return true;
+}
+
+void UC_AComp_SocketCache::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (const ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner()))
+	{
+		Mesh = OwnerCharacter->GetMesh();
+	}
+
+	if (USkeletalMeshComponent* MeshComp = Mesh.Get())
+	{
+		// Listen to the animation finishing, so transforms read earlier in the frame are computed again.
+		BoneTransformsFinalizedHandle = MeshComp->RegisterOnBoneTransformsFinalizedDelegate(
+			FOnBoneTransformsFinalizedMultiCast::FDelegate::CreateUObject(
+				this, &UC_AComp_SocketCache::OnBoneTransformsFinalized));
+
+		// Sockets registered before the mesh was known get resolved now.
+		ResolvedAsset.Reset();
+		ResolveAllSocketsIfMeshChanged();
+	}
+}
+
+void UC_AComp_SocketCache::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USkeletalMeshComponent* MeshComp = Mesh.Get())
+	{
+		MeshComp->UnregisterOnBoneTransformsFinalizedDelegate(BoneTransformsFinalizedHandle);
+	}
+	BoneTransformsFinalizedHandle.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UC_AComp_SocketCache::ResolveSocket(FCachedSocket& CachedSocket) const
+{
+	CachedSocket.BoneIndex = INDEX_NONE;
+	CachedSocket.LocalTransform = FTransform::Identity;
+	CachedSocket.CachedFrame = MAX_uint64;
+
+	const USkeletalMeshComponent* MeshComp = Mesh.Get();
+	if (MeshComp == nullptr)
+	{
+		return;
+	}
+
+	// Sockets are attached to a bone with an offset; plain bone names are used as they are.
+	if (const USkeletalMeshSocket* Socket = MeshComp->GetSocketByName(CachedSocket.SocketName))
+	{
+		CachedSocket.BoneIndex = MeshComp->GetBoneIndex(Socket->BoneName);
+		CachedSocket.LocalTransform = Socket->GetSocketLocalTransform();
+	}
+	else
+	{
+		CachedSocket.BoneIndex = MeshComp->GetBoneIndex(CachedSocket.SocketName);
+	}
+}
+
+void UC_AComp_SocketCache::ResolveAllSocketsIfMeshChanged()
+{
+	const USkeletalMeshComponent* MeshComp = Mesh.Get();
+	if (MeshComp == nullptr || ResolvedAsset.Get() == MeshComp->GetSkinnedAsset())
+	{
+		return;
+	}
+
+	// Bone indices belong to a specific asset, so all of them must be resolved again.
+	ResolvedAsset = MeshComp->GetSkinnedAsset();
+	for (FCachedSocket& CachedSocket : Sockets)
+	{
+		ResolveSocket(CachedSocket);
+	}
+}
+
+void UC_AComp_SocketCache::OnBoneTransformsFinalized()
+{
+	++PoseCounter;
+}
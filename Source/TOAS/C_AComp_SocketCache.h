@@ -0,0 +1,112 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "C_AComp_SocketCache.generated.h"
+
+class USkeletalMeshComponent;
+class USkinnedAsset;
+
+/**
+ * Actor Component that resolves registered socket names to bone indices once, and computes the world transform of
+ * each registered socket at most once per frame after the owner's animation has finished.
+ * Traces, perception, footsteps and VFX read from this cache instead of looking up sockets by name every frame.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class TOAS_API UC_AComp_SocketCache : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this component's properties
+	UC_AComp_SocketCache();
+
+	/**
+	 * Registers a socket (or bone) to be cached, resolving it to its bone index.
+	 * Registering the same name twice returns the same handle.
+	 * @param SocketName Name of the socket or bone in the owner's Skeletal Mesh.
+	 * @return Handle to use when reading the socket's transform.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Socket_Cache")
+	int32 RegisterSocket(const FName& SocketName);
+
+	/**
+	 * Obtains the world transform of a registered socket, computing it only once per frame.
+	 * @param SocketHandle Handle returned when registering the socket.
+	 * @param OutTransform World transform of the socket.
+	 * @return False if the handle is invalid or the socket does not exist in the current Skeletal Mesh.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Socket_Cache")
+	bool GetSocketTransform(const int32 SocketHandle, FTransform& OutTransform);
+
+	/**
+	 * Same as GetSocketTransform, but using the socket's name; registers the socket on its first use.
+	 * @param SocketName Name of the socket or bone in the owner's Skeletal Mesh.
+	 * @param OutTransform World transform of the socket.
+	 * @return False if the socket does not exist in the current Skeletal Mesh.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Socket_Cache")
+	bool GetSocketTransformByName(const FName& SocketName, FTransform& OutTransform);
+
+	// Obtains only the world location of a registered socket. Returns false if the socket does not exist.
+	bool GetSocketLocation(const int32 SocketHandle, FVector& OutLocation);
+
+protected:
+	// Called when the game starts
+	virtual void BeginPlay() override;
+
+	// Called when the component stops playing; releases the mesh delegate.
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	// Cached data of a single registered socket.
+	struct FCachedSocket
+	{
+		// Name the socket was registered with.
+		FName SocketName;
+
+		// Index of the bone the socket is attached to; INDEX_NONE if it doesn't exist in the mesh.
+		int32 BoneIndex = INDEX_NONE;
+
+		// Transform of the socket relative to its bone.
+		FTransform LocalTransform = FTransform::Identity;
+
+		// Last computed world transform.
+		FTransform WorldTransform = FTransform::Identity;
+
+		// Frame and pose in which WorldTransform was computed.
+		uint64 CachedFrame = MAX_uint64;
+		uint32 CachedPose = 0;
+	};
+
+	// Resolves the socket's name into its bone index and local transform.
+	void ResolveSocket(FCachedSocket& CachedSocket) const;
+
+	// Resolves every registered socket again when the Skeletal Mesh asset changes.
+	void ResolveAllSocketsIfMeshChanged();
+
+	// Called once the owner's animation has finished and the bone transforms are final.
+	void OnBoneTransformsFinalized();
+
+	// Every registered socket, indexed by handle.
+	TArray<FCachedSocket> Sockets;
+
+	// Maps socket names to their handles.
+	TMap<FName, int32> SocketHandles;
+
+	// Skeletal Mesh Component the sockets are read from.
+	TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+
+	// Skeletal Mesh asset the bone indices were resolved against.
+	TWeakObjectPtr<const USkinnedAsset> ResolvedAsset;
+
+	// Increased every time the pose is finalized, invalidating transforms read before animation finished.
+	uint32 PoseCounter = 0;
+
+	// Handle of the delegate bound to the mesh's bone transforms being finalized.
+	FDelegateHandle BoneTransformsFinalizedHandle;
+};
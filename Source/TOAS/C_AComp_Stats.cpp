@@ -4,8 +4,12 @@
 
 
 #include "C_AComp_Stats.h"
+#include "C_GI_GameManager.h"
 #include "C_StructsAndEnums.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "C_WS_StatTables.h"
+#include "Engine/DataTable.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
 
 // Sets default values for this component's properties
 UC_AComp_Stats::UC_AComp_Stats()
@@ -14,49 +18,163 @@ UC_AComp_Stats::UC_AComp_Stats()
 	PrimaryComponentTick.bCanEverTick = false;
 }
 
-void UC_AComp_Stats::AddEXP(int32 const &AddedEXP, bool& bLeveledUp)
+int32 UC_AComp_Stats::GetEXPCapToLevelUp() const
+{
+	if (Growth.IsValid() == true)
+	{
+		return Growth->GetEXPCap(Level);
+	}
+	return (100 * GetLevel())-1;
+}
+
+void UC_AComp_Stats::AddEXP(int32 const &AddedEXP, bool& bLeveledUp, int32& LevelsGained)
 {	
 	// Adds EXP Points to the current pool of the Character's,
 	// clamping it from 0 to 9 million 9 hundred and 99 thousand 9 hundred and 99 points.
-	CurrentEXP = UKismetMathLibrary::FClamp(CurrentEXP + AddedEXP, 0, 9999999);
-	// Returns the confirmation of Leveling Up when the obtained EXP surpasses the expected cap.
-	bLeveledUp = CurrentEXP > GetEXPCapToLevelUp();
+	CurrentEXP = FMath::Clamp(CurrentEXP + AddedEXP, 0, 9999999);
+	LevelsGained = 0;
+
+	if (Growth.IsValid() == false)
+	{
+		// Returns the confirmation of Leveling Up when the obtained EXP surpasses the expected cap.
+		bLeveledUp = CurrentEXP > GetEXPCapToLevelUp();
+		return;
+	}
+
+	// A single lookup finds the reached level, however many levels a large grant skips.
+	const uint8 ReachedLevel = Growth->GetLevelForEXP(CurrentEXP);
+	bLeveledUp = ReachedLevel > Level;
+	if (bLeveledUp == true)
+	{
+		LevelsGained = ReachedLevel - Level;
+		Level = ReachedLevel;
+		ApplyGrowth();
+	}
 }
 
 void UC_AComp_Stats::GetPhysicalDamage(const uint8& InstigatorATK, const float &fMultiplier, const EElementalAttribute& Element)
+{
+	const int32 Damage = CalculatePhysicalDamage(InstigatorATK, fMultiplier, Element);
+
+	// Finally, subtract the Current HP by the final calculation of damage; clamping it to ZERO.
+	CurrentHP = static_cast<uint8>(FMath::Clamp(CurrentHP - Damage, 0, static_cast<int32>(MaxHP)));
+}
+
+int32 UC_AComp_Stats::CalculatePhysicalDamage(const uint8 InstigatorATK, const float Multiplier,
+	const EElementalAttribute Element) const
 {
 	// Calculates damage based on the subtraction of the instigator's ATK and the user's DEF.
 	// Clamps damage to 1 in case it goes below ZERO.
-	uint8 Damage = UKismetMathLibrary::Clamp(InstigatorATK - DEF, 1, 255);
+	int32 Damage = FMath::Clamp(InstigatorATK - DEF, 1, 255);
 
 	// Damage is affected by the multiplier variable coming from the attack for added effectiveness.
-	Damage = UKismetMathLibrary::FFloor(Damage * fMultiplier);
+	// Most attacks hit with a multiplier of 1, which stays in integer math.
+	if (Multiplier != 1.0f)
+	{
+		Damage = FMath::FloorToInt32(Damage * Multiplier);
+	}
 
-	// Depending on the element
-	switch (Element)
+	// Depending on the element, damage is scaled by its precomputed percentage;
+	// NON_LETHAL damage is always reduced to ZERO.
+	return Damage * DamagePercents[static_cast<uint8>(Element)] / 100;
+}
+
+void UC_AComp_Stats::SetRES(const EElementalAttribute Element, const uint8 Value)
+{
+	if (Element == EElementalAttribute::NEUTRAL || Element == EElementalAttribute::NON_LETHAL
+		|| Element == EElementalAttribute::MAX)
 	{
-	case EElementalAttribute::FIRE:
-		Damage = UKismetMathLibrary::FFloor(Damage * (((101 - FireRES) * 1.0f) /100.0f));
-		break;
-	case EElementalAttribute::ICE:
-		Damage = UKismetMathLibrary::FFloor(Damage * (((101 - IceRES) * 1.0f) /100.0f));
-		break;
-	case EElementalAttribute::THUNDER:
-		Damage = UKismetMathLibrary::FFloor(Damage * (((101 - ThunderRES) * 1.0f) /100.0f));
-		break;
-	case EElementalAttribute::DARK:
-		Damage = UKismetMathLibrary::FFloor(Damage * (((101 - DarkRES) * 1.0f) /100.0f));
-		break;
-	case EElementalAttribute::NON_LETHAL:
-		// In the case of NON_LETHAL damage, said damage is reduced to ZERO.
-		Damage = 0;
-		break;
-	default:
-		break;
+		return;
 	}
 
-	// Finally, subtract the Current HP by the final calculation of damage; clamping it to ZERO.
-	CurrentHP = UKismetMathLibrary::Clamp(CurrentHP - Damage, 0, MaxHP);
+	Resistances[static_cast<uint8>(Element)] = Value;
+	RebuildDamagePercents();
+}
+
+void UC_AComp_Stats::PostLoad()
+{
+	Super::PostLoad();
+
+	// Assets saved before the Resistances array kept one property per element; a non-zero value means it wasn't moved yet.
+	uint8* const Deprecated[] = { &FireRES_DEPRECATED, &IceRES_DEPRECATED, &ThunderRES_DEPRECATED, &DarkRES_DEPRECATED };
+	const EElementalAttribute Elements[] = { EElementalAttribute::FIRE, EElementalAttribute::ICE,
+		EElementalAttribute::THUNDER, EElementalAttribute::DARK };
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Deprecated); ++Index)
+	{
+		if (*Deprecated[Index] != 0)
+		{
+			Resistances[static_cast<uint8>(Elements[Index])] = *Deprecated[Index];
+			*Deprecated[Index] = 0;
+		}
+	}
+}
+
+void UC_AComp_Stats::RebuildDamagePercents()
+{
+	for (int32 Index = 0; Index < ElementCount; ++Index)
+	{
+		// Each Resistance point takes 1% off, starting from 101%.
+		DamagePercents[Index] = static_cast<uint8>(FMath::Max(101 - Resistances[Index], 0));
+	}
+
+	// Neutral attacks can't be resisted, and Non-Lethal ones never hurt.
+	DamagePercents[static_cast<uint8>(EElementalAttribute::NEUTRAL)] = 100;
+	DamagePercents[static_cast<uint8>(EElementalAttribute::NON_LETHAL)] = 0;
+}
+
+void UC_AComp_Stats::RestoreStats(const uint8 InLevel, const uint8 InCurrentHP)
+{
+	Level = InLevel;
+	ApplyGrowth();
+	CurrentHP = FMath::Min(InCurrentHP, MaxHP);
+}
+
+void UC_AComp_Stats::ExportStats(FSavedStats& OutStats) const
+{
+	OutStats.Level = Level;
+	OutStats.CurrentEXP = CurrentEXP;
+	OutStats.MaxHP = MaxHP;
+	OutStats.CurrentHP = CurrentHP;
+	OutStats.ATK = ATK;
+	OutStats.DEF = DEF;
+	FMemory::Memcpy(OutStats.Resistances, Resistances, sizeof(Resistances));
+}
+
+void UC_AComp_Stats::ImportStats(const FSavedStats& InStats)
+{
+	if (InStats.Level == 0)
+	{
+		return;
+	}
+
+	// Saved stats are taken as they are, so bonuses gained outside of the Growth Table survive loading.
+	Level = InStats.Level;
+	CurrentEXP = InStats.CurrentEXP;
+	MaxHP = InStats.MaxHP;
+	CurrentHP = FMath::Min(InStats.CurrentHP, MaxHP);
+	ATK = InStats.ATK;
+	DEF = InStats.DEF;
+	FMemory::Memcpy(Resistances, InStats.Resistances, sizeof(Resistances));
+	RebuildDamagePercents();
+}
+
+void UC_AComp_Stats::ApplyGrowth()
+{
+	if (Growth.IsValid() == false)
+	{
+		return;
+	}
+
+	const FStatBlock& Block = Growth->GetBlock(Level);
+	const uint8 LostHP = MaxHP - FMath::Min(CurrentHP, MaxHP);
+
+	MaxHP = Block.MaxHP;
+	ATK = Block.ATK;
+	DEF = Block.DEF;
+	FMemory::Memcpy(Resistances, Block.Resistances, sizeof(Resistances));
+	RebuildDamagePercents();
+
+	CurrentHP = MaxHP > LostHP ? MaxHP - LostHP : 0;
 }
 
 // Called when the game starts
@@ -64,8 +182,48 @@ void UC_AComp_Stats::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// ...
+	RebuildDamagePercents();
+
+	if (GrowthTable != nullptr)
+	{
+		if (UC_WS_StatTables* StatTables = GetWorld()->GetSubsystem<UC_WS_StatTables>())
+		{
+			Growth = StatTables->FindOrBake(*GrowthTable);
+		}
+		else
+		{
+			Growth = MakeShared<FStatGrowthTable>(FStatGrowthTable::Bake(*GrowthTable));
+		}
+		ApplyGrowth();
+	}
 
 	CurrentHP = MaxHP;
-	
+
+	// The player character spawned after a load takes the stats of the Save Data, whether it's possessed already
+	// or only later on.
+	if (APawn* Pawn = Cast<APawn>(GetOwner()))
+	{
+		Pawn->ReceiveControllerChangedDelegate.AddDynamic(this, &UC_AComp_Stats::OnOwnerControllerChanged);
+		ImportSavedPlayerStats();
+	}
+}
+
+void UC_AComp_Stats::OnOwnerControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
+{
+	ImportSavedPlayerStats();
+}
+
+void UC_AComp_Stats::ImportSavedPlayerStats()
+{
+	const APawn* Pawn = Cast<APawn>(GetOwner());
+	if (bImportedSavedPlayerStats == true || Pawn == nullptr || Pawn->IsPlayerControlled() == false)
+	{
+		return;
+	}
+
+	if (const UC_GI_GameManager* GameManager = Cast<UC_GI_GameManager>(Pawn->GetGameInstance()))
+	{
+		bImportedSavedPlayerStats = true;
+		ImportStats(GameManager->GetSavedPlayerStats());
+	}
 }
\ No newline at end of file
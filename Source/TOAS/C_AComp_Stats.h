@@ -9,8 +9,14 @@
 #include "Components/ActorComponent.h"
 #include "C_AComp_Stats.generated.h"
 
+class AController;
+class APawn;
+class UDataTable;
+struct FStatGrowthTable;
+
 /**
  * Actor Component that stores stats such as Levles, Experience, Attack, Defense, and also Resistances to Elements.
+ * With a Growth Table, the stats of each level and the Experience to reach it come from the table instead.
  */
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class TOAS_API UC_AComp_Stats : public UActorComponent
@@ -31,16 +37,18 @@ public:
 	
 	// Caps the Experience to reach the next level based on the current Level before confirmation. 
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Stats_Getters")
-	int32 GetEXPCapToLevelUp() const { return (100 * GetLevel())-1; }
+	int32 GetEXPCapToLevelUp() const;
 	
 	/**
 	 * Function called to add EXP to the pool of the Character's.
 	 * Returns a boolean telling if the character leveled up after this increase.
+	 * With a Growth Table, the character also levels up right away, as many levels as the Experience reaches.
 	 * @param AddedEXP Experience Points to add to this Character's pool of EXP.
 	 * @param bLeveledUp Checks whether the character has leveled up after having received Experience Points.
+	 * @param LevelsGained Amount of levels gained; always 0 without a Growth Table.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Stats_Setters")
-	void AddEXP(int32 const &AddedEXP, bool &bLeveledUp);
+	void AddEXP(int32 const &AddedEXP, bool &bLeveledUp, int32 &LevelsGained);
 	
 	/**
 	 * Getter of the currently possible Maximum amount of Hit Points. 
@@ -70,37 +78,49 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Stats_Getters")
 	uint8 GetDEF() const { return DEF; }
 
+	/**
+	 * Getter of the Resistance points to an element.
+	 * Neutral and Non-Lethal attacks can't be resisted, so their points are always ZERO.
+	 * @param Element Element whose Resistance to get.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Stats_Getters")
+	uint8 GetRES(const EElementalAttribute Element) const { return Resistances[static_cast<uint8>(Element)]; }
+
+	/**
+	 * Setter of the Resistance points to an element; ignored for Neutral and Non-Lethal.
+	 * @param Element Element whose Resistance to set.
+	 * @param Value New Resistance points.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats_Setters")
+	void SetRES(const EElementalAttribute Element, const uint8 Value);
+
 	/**
 	 * Getter of the Fire Resistance points.
 	 * Reduces Damage from attacks with Fire properties.
-	 * @return FireRES property.
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Stats_Getters")
-	uint8 GetFireRES() const { return FireRES; }
+	uint8 GetFireRES() const { return GetRES(EElementalAttribute::FIRE); }
 
 	/**
 	 * Getter of the Ice Resistance points.
 	 * Reduces Damage from attacks with Ice properties.
-	 * @return IceRES property.
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Stats_Getters")
-	uint8 GetIceRES() const { return IceRES; }
+	uint8 GetIceRES() const { return GetRES(EElementalAttribute::ICE); }
 
 	/**
 	 * Getter of the Thunder Resistance points.
 	 * Reduces Damage from attacks with Thunder properties.
-	 * @return ThunderRES property.
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Stats_Getters")
-	uint8 GetThunderRES() const { return ThunderRES; }
+	uint8 GetThunderRES() const { return GetRES(EElementalAttribute::THUNDER); }
 
 	/**
 	 * Getter of the Darkness Resistance points.
 	 * Reduces Damage from attacks with Darkness properties.
-	 * @return DarkRES property.
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Stats_Getters")
-	uint8 GetDarkRES() const { return DarkRES; }
+	uint8 GetDarkRES() const { return GetRES(EElementalAttribute::DARK); }
 
 	/**
 	 * Function that receives physical damage from physical weapons. Can be affected by the DEF Stat.
@@ -112,7 +132,36 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Damage_Calculators")
 	void GetPhysicalDamage(const uint8 &InstigatorATK, const float &fMultiplier, const EElementalAttribute &Element = EElementalAttribute::NEUTRAL );
 
+	// Works out the Hit Points a physical hit would take from this character, without taking them.
+	int32 CalculatePhysicalDamage(const uint8 InstigatorATK, const float Multiplier,
+		const EElementalAttribute Element) const;
+
+	/**
+	 * Restores the Level and Hit Points of a character that was kept outside of the world, like crowd members.
+	 * @param InLevel Level to restore.
+	 * @param InCurrentHP Hit Points to restore; clamped to MaxHP.
+	 */
+	void RestoreStats(const uint8 InLevel, const uint8 InCurrentHP);
+
+	// Copies every stat into the block kept by the Save Data.
+	void ExportStats(FSavedStats& OutStats) const;
+
+	// Restores every stat from a block kept by the Save Data; ignored if the block is empty.
+	void ImportStats(const FSavedStats& InStats);
+
 private:
+	// Copies the stats of the current Level from the Growth Table, keeping the Hit Points lost so far.
+	void ApplyGrowth();
+
+	// Data Table of FStatGrowthRow with the stats of each level of this character's class.
+	// Baked once per table and shared by every character using it.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Stats", meta=(AllowPrivateAccess=true,
+		RequiredAssetDataTags="RowStructure=/Script/TOAS.StatGrowthRow"))
+	TObjectPtr<UDataTable> GrowthTable;
+
+	// Baked version of the Growth Table.
+	TSharedPtr<const FStatGrowthTable> Growth;
+
 	// Current Level that determines a character's abilities and power. 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats", meta=(AllowPrivateAccess=true))
 	uint8 Level = 1;
@@ -138,24 +187,45 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats", meta=(AllowPrivateAccess=true))
 	uint8 DEF = 2;
 
-	// Current amount of Resistance to fire based attacks. 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats", meta=(AllowPrivateAccess=true))
-	uint8 FireRES = 0;
+	// Current amount of Resistance to each element; only fire, ice, electric and darkness based attacks use it.
+	// Edited through GetRES and SetRES in Blueprints, so the damage table stays up to date.
+	UPROPERTY(EditAnywhere, Category="Stats", meta=(ArraySizeEnum="EElementalAttribute"))
+	uint8 Resistances[ElementCount] = {};
 
-	// Current amount of Resistance to ice based attacks. 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats", meta=(AllowPrivateAccess=true))
-	uint8 IceRES = 0;
+	// Percentage of damage taken from each element, rebuilt whenever the resistances change.
+	uint8 DamagePercents[ElementCount] = {};
 
-	// Current amount of Resistance to electric based attacks. 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats", meta=(AllowPrivateAccess=true))
-	uint8 ThunderRES = 0;
+	// Former per-element Resistances, only kept to move the values saved in older assets into Resistances on load.
+	UPROPERTY(meta=(DeprecatedProperty, DeprecationMessage="Use GetRES and SetRES with the Fire element instead."))
+	uint8 FireRES_DEPRECATED = 0;
 
-	// Current amount of Resistance to darkness based attacks. 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats", meta=(AllowPrivateAccess=true))
-	uint8 DarkRES = 0;
+	UPROPERTY(meta=(DeprecatedProperty, DeprecationMessage="Use GetRES and SetRES with the Ice element instead."))
+	uint8 IceRES_DEPRECATED = 0;
+
+	UPROPERTY(meta=(DeprecatedProperty, DeprecationMessage="Use GetRES and SetRES with the Thunder element instead."))
+	uint8 ThunderRES_DEPRECATED = 0;
+
+	UPROPERTY(meta=(DeprecatedProperty, DeprecationMessage="Use GetRES and SetRES with the Dark element instead."))
+	uint8 DarkRES_DEPRECATED = 0;
+
+	// Rebuilds the damage percentages out of the resistances.
+	void RebuildDamagePercents();
+
+	// Takes the player stats kept by the Save Data once the owner is controlled by the player.
+	void ImportSavedPlayerStats();
+
+	// Imports the saved player stats when the owner becomes controlled by the player after Begin Play.
+	UFUNCTION()
+	void OnOwnerControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
+	// Whether the saved player stats were imported already; later possessions keep the stats gained since.
+	bool bImportedSavedPlayerStats = false;
 
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+
+	// Moves the Resistances saved by older assets into the Resistances array.
+	virtual void PostLoad() override;
 	
 };
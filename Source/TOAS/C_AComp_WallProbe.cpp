@@ -0,0 +1,123 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_AComp_WallProbe.h"
+#include "TOAS.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Wall Probe"), STAT_TOAS_WallProbe, STATGROUP_TOAS);
+
+// Sets default values for this component's properties
+UC_AComp_WallProbe::UC_AComp_WallProbe()
+{
+	// This component does not need to Tick; its owner probes when it can slide on walls.
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UC_AComp_WallProbe::Probe(const FVector& Location, const FVector& ProbeVector, const float UpOffset,
+	const TArray<TEnumAsByte<EObjectTypeQuery>>& ObjectTypes)
+{
+	TOAS_SCOPE(WallProbe);
+
+	ReadProbeResults();
+
+	// While the owner barely moved or turned, the last result stays valid.
+	const FVector ProbeDirection = ProbeVector.GetSafeNormal();
+	const float Tolerance = FMath::Max(PositionTolerance, GetOwner()->GetVelocity().Size() * ToleranceTime);
+	if (bHasProbed == true
+		&& FVector::DistSquared(Location, LastProbeLocation) <= FMath::Square(Tolerance)
+		&& (ProbeDirection | LastProbeDirection) >= FMath::Cos(FMath::DegreesToRadians(DirectionTolerance)))
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	const FCollisionObjectQueryParams ObjectQueryParams(ObjectTypes);
+	// Same settings the Kismet traces used: simple collision and ignoring the owner.
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TOASWallProbe), false, GetOwner());
+	const FVector VerticalOffset(0.0f, 0.0f, UpOffset);
+
+	// Both rays are issued together and read together on the next frame.
+	UpperTraceHandle = World->AsyncLineTraceByObjectType(EAsyncTraceType::Single, Location + VerticalOffset,
+		Location + ProbeVector + VerticalOffset, ObjectQueryParams, QueryParams);
+	LowerTraceHandle = World->AsyncLineTraceByObjectType(EAsyncTraceType::Single, Location - VerticalOffset,
+		Location + ProbeVector - VerticalOffset, ObjectQueryParams, QueryParams);
+
+	bProbeInFlight = true;
+	bHasProbed = true;
+	LastProbeLocation = Location;
+	LastProbeDirection = ProbeDirection;
+}
+
+void UC_AComp_WallProbe::ClearContact()
+{
+	bProbeInFlight = false;
+	bHasProbed = false;
+	ConsecutiveMisses = 0;
+	SetWallContact(false);
+}
+
+void UC_AComp_WallProbe::ReadProbeResults()
+{
+	if (bProbeInFlight == false)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	FTraceDatum UpperData;
+	FTraceDatum LowerData;
+	const bool bUpperReady = World->QueryTraceData(UpperTraceHandle, UpperData);
+	const bool bLowerReady = World->QueryTraceData(LowerTraceHandle, LowerData);
+
+	// Handles expire after one frame; if the results were missed, the next call probes again.
+	bProbeInFlight = false;
+	if (bUpperReady == false || bLowerReady == false)
+	{
+		bHasProbed = false;
+		return;
+	}
+
+	const FHitResult* UpperHit = FHitResult::GetFirstBlockingHit(UpperData.OutHits);
+	const FHitResult* LowerHit = FHitResult::GetFirstBlockingHit(LowerData.OutHits);
+
+	// Just like before, both the upper and lower body must be facing a wall.
+	if (UpperHit != nullptr && LowerHit != nullptr)
+	{
+		ConsecutiveMisses = 0;
+		WallNormal = LowerHit->Normal;
+		SetWallContact(true);
+		return;
+	}
+
+	// While in contact, a single miss may be a gap in the wall; probe again right away instead of reusing it.
+	if (bHasWallContact == true && ++ConsecutiveMisses < MissesToExit)
+	{
+		bHasProbed = false;
+		return;
+	}
+
+	ConsecutiveMisses = 0;
+	SetWallContact(false);
+}
+
+void UC_AComp_WallProbe::SetWallContact(const bool bNewContact)
+{
+	if (bHasWallContact == bNewContact)
+	{
+		return;
+	}
+
+	bHasWallContact = bNewContact;
+
+	if (bHasWallContact == true)
+	{
+		OnWallContactBegin.Broadcast();
+	}
+	else
+	{
+		OnWallContactEnd.Broadcast();
+	}
+}
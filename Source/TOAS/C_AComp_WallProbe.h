@@ -0,0 +1,107 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+#include "Components/ActorComponent.h"
+#include "C_AComp_WallProbe.generated.h"
+
+// Delegation of the Wall Contact starting or ending.
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FWallContactEvent);
+
+/**
+ * Actor Component that looks for a wall in front of the owner with two rays (upper and lower body),
+ * issued together as asynchronous physics queries and read on the following frame.
+ * The last result is reused while the owner's position and probing direction stay within a tolerance
+ * that grows with the owner's speed, and contact is only lost after several consecutive misses, so it doesn't flicker along uneven walls.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class TOAS_API UC_AComp_WallProbe : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this component's properties
+	UC_AComp_WallProbe();
+
+	// Delegate called when contact with a wall begins.
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FWallContactEvent OnWallContactBegin;
+
+	// Delegate called when contact with a wall ends.
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FWallContactEvent OnWallContactEnd;
+
+	/**
+	 * Reads the results of the last probe and, if the owner moved or turned enough, probes again.
+	 * @param Location World Location the rays start from (before the vertical offsets).
+	 * @param ProbeVector Direction and length of both rays.
+	 * @param UpOffset Vertical offset of the upper ray; the lower ray uses the same offset downwards.
+	 * @param ObjectTypes Object types that count as walls.
+	 */
+	void Probe(const FVector& Location, const FVector& ProbeVector, const float UpOffset,
+		const TArray<TEnumAsByte<EObjectTypeQuery>>& ObjectTypes);
+
+	// Forgets the last probe and ends any contact right away, like when landing or releasing the stick.
+	void ClearContact();
+
+	// Checks if the owner is currently against a wall.
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall_Probe")
+	bool HasWallContact() const { return bHasWallContact; }
+
+	// Normal of the wall currently in contact.
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall_Probe")
+	FVector GetWallNormal() const { return WallNormal; }
+
+protected:
+	// Distance (in cm) the owner must move before the wall is probed again, when moving slowly.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wall_Probe", meta = (AllowPrivateAccess = "true"))
+	float PositionTolerance = 10.0f;
+
+	// Seconds of the owner's movement the last result covers; faster owners reuse it over a longer distance,
+	// so the result lasts about as long at any speed instead of expiring every frame once running.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wall_Probe", meta = (AllowPrivateAccess = "true"))
+	float ToleranceTime = 0.05f;
+
+	// Angle (in degrees) the probing direction must turn before the wall is probed again.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wall_Probe", meta = (AllowPrivateAccess = "true"))
+	float DirectionTolerance = 10.0f;
+
+	// Consecutive probes without a wall before contact is lost.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wall_Probe", meta = (AllowPrivateAccess = "true"))
+	int32 MissesToExit = 2;
+
+private:
+	// Reads the rays issued on a previous frame, if their results are ready, and updates the contact.
+	void ReadProbeResults();
+
+	// Sets the contact state, broadcasting the matching event when it changes.
+	void SetWallContact(const bool bNewContact);
+
+	// Handles of the upper and lower rays in flight.
+	FTraceHandle UpperTraceHandle;
+	FTraceHandle LowerTraceHandle;
+
+	// Whether both rays are in flight, waiting for their results.
+	bool bProbeInFlight = false;
+
+	// Whether a probe was issued since the last time contact was cleared.
+	bool bHasProbed = false;
+
+	// Location and normalized direction of the last probe.
+	FVector LastProbeLocation = FVector::ZeroVector;
+	FVector LastProbeDirection = FVector::ZeroVector;
+
+	// Current contact state.
+	bool bHasWallContact = false;
+
+	// Normal of the wall in contact.
+	FVector WallNormal = FVector::ZeroVector;
+
+	// Consecutive probes that didn't find a wall while in contact.
+	int32 ConsecutiveMisses = 0;
+};
@@ -5,6 +5,20 @@
 
 #include "C_ANS_ContinuousAttackNotify.h"
 #include "TOASCharacter.h"
+#include "C_AComp_SocketCache.h"
+#include "C_WS_CombatQueryScheduler.h"
+#include "Animation/AnimNotifyQueue.h"
+
+namespace
+{
+	// Montage instance playing the notify, which tells apart two instances of a montage blending into itself.
+	int32 GetMontageInstanceID(const FAnimNotifyEventReference& EventReference)
+	{
+		const UE::Anim::FAnimNotifyMontageInstanceContext* Context =
+			EventReference.GetContextData<UE::Anim::FAnimNotifyMontageInstanceContext>();
+		return Context != nullptr ? Context->MontageInstanceID : INDEX_NONE;
+	}
+}
 
 void UC_ANS_ContinuousAttackNotify::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
 	float TotalDuration, const FAnimNotifyEventReference& EventReference)
@@ -17,8 +31,23 @@ void UC_ANS_ContinuousAttackNotify::NotifyBegin(USkeletalMeshComponent* MeshComp
 		// Then the owner of said Mesh Component is casted as an ATOASCharacter class.
 		if (ATOASCharacter* aThisAttacker = Cast<ATOASCharacter>(MeshComp->GetOwner()))
 		{
-			// And if the cast is successful, set it as the attacker of this notify.
-			Attacker = aThisAttacker;
+			// The AttackProperties are only compiled once, for every swing and every mesh using this notify.
+			if (CompiledAttack.IsValid() == false)
+			{
+				CompiledAttack = MakeShared<FAttackDescriptor>(FAttackDescriptor::Compile(AttackProperties));
+			}
+
+			// And if the cast is successful, start a fresh swing for this Mesh with it as the attacker.
+			// A new swing has nothing to interpolate from yet, and has not hit anyone yet.
+			FContinuousAttackRuntime& Runtime = RuntimeStates.FindOrAdd(TObjectKey<USkeletalMeshComponent>(MeshComp));
+			const int32 ActiveSwings = Runtime.ActiveSwings + 1;
+			Runtime = FContinuousAttackRuntime();
+			Runtime.ActiveSwings = ActiveSwings;
+			Runtime.MontageInstanceID = GetMontageInstanceID(EventReference);
+			Runtime.Attacker = aThisAttacker;
+			Runtime.StartBoneName = AttackProperties.StartBoneName;
+			Runtime.EndBoneName = AttackProperties.EndBoneName;
+			Runtime.SwingHitRegistry = MakeShared<FAttackHitRegistry>();
 		}
 	}
 }
@@ -28,34 +57,44 @@ void UC_ANS_ContinuousAttackNotify::NotifyTick(USkeletalMeshComponent* MeshComp,
 {
 	Super::NotifyTick(MeshComp, Animation, FrameDeltaTime, EventReference);
 
-	// Is the Attacker has not been correctly registered in its reference, do not proceed with further code.
-	if (IsValid(Attacker) == false)
+	FContinuousAttackRuntime* Runtime = FindRuntimeState(MeshComp);
+
+	// Is the Attacker has not been correctly registered for this Mesh, do not proceed with further code.
+	// Neither if this tick comes from an older swing still blending out; only the latest one sweeps.
+	if (Runtime == nullptr || Runtime->Attacker.IsValid() == false
+		|| Runtime->MontageInstanceID != GetMontageInstanceID(EventReference))
 	{
 		return;
 	}
 
+	ATOASCharacter* Attacker = Runtime->Attacker.Get();
+
 	// Now, if the OverrideAttackLocation hasn't been modified,
 	if (AttackProperties.OverrideAttackLocation == FVector::ZeroVector)
 	{
 		// as long as both StartBoneName and EndBoneName are distinct from "Default",
 		// proceed to locate the respective sockets' world location. 
-		if (AttackProperties.StartBoneName != FName("Default") && AttackProperties.EndBoneName != FName("Default"))
+		if (Runtime->StartBoneName != FName("Default") && Runtime->EndBoneName != FName("Default"))
 		{
-			// Make sure the sockets do exist in the Skeletal Mesh to modify unset Location Parameters.
-			if (Attacker->GetMesh()->DoesSocketExist(AttackProperties.StartBoneName))
-			{
-				StartLocation = Attacker->GetMesh()->GetSocketLocation(AttackProperties.StartBoneName);
-			}
-			if (Attacker->GetMesh()->DoesSocketExist(AttackProperties.EndBoneName))
+			UC_AComp_SocketCache* SocketCache = Attacker->GetSocketCache();
+
+			// Sockets are resolved once per swing (sub-classes may have changed their names on NotifyBegin).
+			if (Runtime->StartSocketHandle == INDEX_NONE)
 			{
-				EndLocation = Attacker->GetMesh()->GetSocketLocation(AttackProperties.EndBoneName);
+				Runtime->StartSocketHandle = SocketCache->RegisterSocket(Runtime->StartBoneName);
+				Runtime->EndSocketHandle = SocketCache->RegisterSocket(Runtime->EndBoneName);
 			}
+
+			// The cache only updates the Locations if the sockets do exist in the Skeletal Mesh,
+			// keeping the previous values otherwise.
+			SocketCache->GetSocketLocation(Runtime->StartSocketHandle, Runtime->StartLocation);
+			SocketCache->GetSocketLocation(Runtime->EndSocketHandle, Runtime->EndLocation);
 		}
 		// Otherwise, set the StartLocation and EndLocation to the Attacker's Location.
 		else
 		{
-			StartLocation = Attacker->GetActorLocation();
-			EndLocation = Attacker->GetActorLocation();
+			Runtime->StartLocation = Attacker->GetActorLocation();
+			Runtime->EndLocation = Attacker->GetActorLocation();
 		}
 	}
 	// However, if the AttackProperties has OverrideAttackLocation changed from Zeros,
@@ -68,17 +107,85 @@ void UC_ANS_ContinuousAttackNotify::NotifyTick(USkeletalMeshComponent* MeshComp,
 		// which will be joined together in one FVector value,
 		FVector OverrideLocation = FwdLocation + SideLocation + UpLocation;
 		// and finally, set to the StartLocation and EndLocation variables in relation to the Attacker's location.
-		StartLocation = Attacker->GetActorLocation() + OverrideLocation;
-		EndLocation = Attacker->GetActorLocation() + OverrideLocation;
+		Runtime->StartLocation = Attacker->GetActorLocation() + OverrideLocation;
+		Runtime->EndLocation = Attacker->GetActorLocation() + OverrideLocation;
+	}
+	// Without sub-stepping, or on the first tick of the swing, a single sweep is enough.
+	if (bSubStepSweeps == false || Runtime->bHasPreviousSample == false)
+	{
+		SendSweep(Attacker, *Runtime, Runtime->StartLocation, Runtime->EndLocation);
+	}
+	else
+	{
+		// The amount of sweeps depends on how far either end of the weapon travelled, not on the frame rate.
+		const float Travel = FMath::Max(FVector::Dist(Runtime->PreviousStartLocation, Runtime->StartLocation),
+			FVector::Dist(Runtime->PreviousEndLocation, Runtime->EndLocation));
+
+		// A weapon that barely moved is still swept once where it stands, so characters walking into it get hit;
+		// only the interpolation is skipped.
+		const int32 SubSteps = FMath::Clamp(FMath::CeilToInt32(Travel / SubStepResolution), 1, MaxSubSteps);
+
+		// Interpolate the weapon segment from the last swept one up to the current one.
+		for (int32 Step = 1; Step <= SubSteps; ++Step)
+		{
+			const float Alpha = static_cast<float>(Step) / SubSteps;
+			SendSweep(Attacker, *Runtime, FMath::Lerp(Runtime->PreviousStartLocation, Runtime->StartLocation, Alpha),
+				FMath::Lerp(Runtime->PreviousEndLocation, Runtime->EndLocation, Alpha));
+		}
 	}
-	// Finally, send the resulting Locations and Properties to the Attacker's function to Trace Attacks.
-	Attacker->TraceAttack(StartLocation, EndLocation, AttackProperties);
+
+	// Store the swept segment as the origin for the next interpolation.
+	Runtime->PreviousStartLocation = Runtime->StartLocation;
+	Runtime->PreviousEndLocation = Runtime->EndLocation;
+	Runtime->bHasPreviousSample = true;
+}
+
+void UC_ANS_ContinuousAttackNotify::SendSweep(ATOASCharacter* Attacker, const FContinuousAttackRuntime& Runtime,
+	const FVector& SweepStart, const FVector& SweepEnd) const
+{
+	// Send the Locations and Properties to the Combat Query Scheduler, which batches every sweep
+	// of the frame and resolves them on the next one.
+	if (UC_WS_CombatQueryScheduler* Scheduler = Attacker->GetWorld()->GetSubsystem<UC_WS_CombatQueryScheduler>())
+	{
+		Scheduler->QueueSweep(Attacker, SweepStart, SweepEnd, CompiledAttack, false, Runtime.SwingHitRegistry);
+		return;
+	}
+	// Worlds without a scheduler (like editor previews) fall back to the Attacker's function to Trace Attacks.
+	Attacker->TraceAttackDescriptor(SweepStart, SweepEnd, *CompiledAttack, false, Runtime.SwingHitRegistry.Get());
 }
 
 void UC_ANS_ContinuousAttackNotify::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
 	const FAnimNotifyEventReference& EventReference)
 {
 	Super::NotifyEnd(MeshComp, Animation, EventReference);
-	// When the Anim Notify State ends, release the attacker's pointer for good practices.
-	Attacker = nullptr;
+	// When the Anim Notify State ends, release this Mesh's swing for good practices,
+	// unless a newer swing already began on it and is still going.
+	// Sweeps still in flight keep their own reference to the registry, so the swing's hits stay unique.
+	FContinuousAttackRuntime* Runtime = FindRuntimeState(MeshComp);
+	if (Runtime != nullptr && --Runtime->ActiveSwings <= 0)
+	{
+		RuntimeStates.Remove(TObjectKey<USkeletalMeshComponent>(MeshComp));
+	}
+
+	// Meshes destroyed mid-swing never reach NotifyEnd, so their states are dropped every now and then.
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastStalePurgeTime >= StalePurgeInterval)
+	{
+		LastStalePurgeTime = Now;
+		for (auto It = RuntimeStates.CreateIterator(); It; ++It)
+		{
+			if (It.Key().ResolveObjectPtr() == nullptr)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UC_ANS_ContinuousAttackNotify::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	CompiledAttack.Reset();
 }
+#endif
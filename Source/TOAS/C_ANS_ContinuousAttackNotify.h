@@ -11,6 +11,50 @@
 
 class ATOASCharacter;
 
+// Runtime state of a swing. Kept per Skeletal Mesh Component, because the notify object itself is shared
+// by every mesh playing the same montage.
+struct FContinuousAttackRuntime
+{
+	// Stores the reference to the attacker of this swing.
+	TWeakObjectPtr<ATOASCharacter> Attacker;
+
+	// Name of the socket where the Trace begins; starts as the AttackProperties' one but may be overridden per swing.
+	FName StartBoneName;
+
+	// Name of the socket where the Trace ends; starts as the AttackProperties' one but may be overridden per swing.
+	FName EndBoneName;
+
+	// Handles of both sockets in the Attacker's Socket Cache, registered on the first tick of the swing.
+	int32 StartSocketHandle = INDEX_NONE;
+	int32 EndSocketHandle = INDEX_NONE;
+
+	// Used to store the Location from where the Trace will begin.
+	FVector StartLocation = FVector::ZeroVector;
+
+	// Used to store the Location from where the Trace will end.
+	FVector EndLocation = FVector::ZeroVector;
+
+	// Start Location of the last sweep, used as the origin of the interpolation.
+	FVector PreviousStartLocation = FVector::ZeroVector;
+
+	// End Location of the last sweep, used as the origin of the interpolation.
+	FVector PreviousEndLocation = FVector::ZeroVector;
+
+	// Marked true once the first sweep of the swing was done, so there is a previous segment to interpolate from.
+	bool bHasPreviousSample = false;
+
+	// Actors hit during the current swing; each one is damaged at most once per swing.
+	TSharedPtr<FAttackHitRegistry> SwingHitRegistry;
+
+	// Swings begun on the Mesh and not ended yet. A montage blending into itself begins the next swing
+	// before ending the previous one, so the state is only released once every swing has ended.
+	int32 ActiveSwings = 0;
+
+	// Montage instance playing the latest swing; ticks of the instance blending out are ignored,
+	// so the shared state isn't swept twice per frame. INDEX_NONE outside montages.
+	int32 MontageInstanceID = INDEX_NONE;
+};
+
 /**
  * Anim Notify State to be used for attack animations that have multiple frames where attacks can be registered.
  * For example, sword swings.
@@ -22,7 +66,7 @@ class TOAS_API UC_ANS_ContinuousAttackNotify : public UAnimNotifyState
 
 public:
 	// The overridden NotifyBegin event called when the Anim Notify State has begun.
-	// Sets the TOASCharacter using this Anim Notify State as the Attacker. 
+	// Registers the runtime state of the swing for this Mesh, with the TOASCharacter using it as the Attacker. 
 	// It's not UFUNCTION() because it can be overridden by sub-classes of this Anim Notify State class.
 	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
 	// The overridden NotifyTick event called for as long as the Anim Notify State lasts before ending.
@@ -31,24 +75,57 @@ public:
 	UFUNCTION()
 	virtual void NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime, const FAnimNotifyEventReference& EventReference) override;
 	// The overridden NotifyTick event called when the Anim Notify State reaches its end.
-	// Removes the reference to the Attacker for good practices.
+	// Removes the runtime state of this Mesh's swing for good practices.
 	UFUNCTION()
 	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
 
+#if WITH_EDITOR
+	// Discards the compiled attack when the AttackProperties are edited, so the next swing compiles them again.
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 protected:
 	// A struct to organize and store universally recognized attack properties.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Properties", meta = (AllowPrivateAccess = "true"))
 	FAttackProperties AttackProperties;
 
-	// Stores the reference to the attacker of this Anim Notify State for attacks.
-	UPROPERTY()
-	ATOASCharacter* Attacker;
+	// If true, the weapon segment is interpolated between last frame's Locations and this frame's,
+	// sweeping as many times as the distance travelled requires instead of once per rendered frame.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Properties|SubStepping",
+		meta = (AllowPrivateAccess = "true"))
+	bool bSubStepSweeps = true;
 
-	// Used to store the Location from where the Trace will begin.
-	UPROPERTY()
-	FVector StartLocation;
-	
-	// Used to store the Location from where the Trace will end.
-	UPROPERTY()
-	FVector EndLocation;
+	// Distance (in cm) the weapon must travel to need another sweep. Usually close to the attack's radius.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Properties|SubStepping",
+		meta = (AllowPrivateAccess = "true", EditCondition = "bSubStepSweeps", ClampMin = "1.0"))
+	float SubStepResolution = 20.0f;
+
+	// Caps the amount of sweeps a single tick can produce, no matter how far the weapon travelled.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Properties|SubStepping",
+		meta = (AllowPrivateAccess = "true", EditCondition = "bSubStepSweeps", ClampMin = "1"))
+	int32 MaxSubSteps = 8;
+
+	// AttackProperties compiled into their ready-to-trace form; shared with the sweeps waiting on the scheduler.
+	TSharedPtr<const FAttackDescriptor> CompiledAttack;
+
+	// Runtime state of every swing currently using this notify, keyed by the Mesh playing it.
+	// Entries are added on NotifyBegin and removed on NotifyEnd, so ticking never allocates;
+	// entries of Meshes destroyed mid-swing are purged by a NotifyEnd, at most once per StalePurgeInterval.
+	TMap<TObjectKey<USkeletalMeshComponent>, FContinuousAttackRuntime> RuntimeStates;
+
+	// Seconds between walks of the runtime states looking for destroyed Meshes.
+	static constexpr double StalePurgeInterval = 10.0;
+
+	// Time the runtime states were last walked for destroyed Meshes.
+	double LastStalePurgeTime = 0.0;
+
+	// Finds the runtime state of the swing being played by the Mesh, if any.
+	FORCEINLINE FContinuousAttackRuntime* FindRuntimeState(const USkeletalMeshComponent* MeshComp)
+	{
+		return RuntimeStates.Find(TObjectKey<USkeletalMeshComponent>(MeshComp));
+	}
+
+	// Sends a single sweep to the Combat Query Scheduler, or traces it right away if there is no scheduler.
+	void SendSweep(ATOASCharacter* Attacker, const FContinuousAttackRuntime& Runtime, const FVector& SweepStart,
+		const FVector& SweepEnd) const;
 };
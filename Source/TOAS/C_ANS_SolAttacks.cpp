@@ -11,20 +11,21 @@ void UC_ANS_SolAttacks::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSeque
 {
 	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
 
-	// Only works if the Attacker's reference is valid.
-	if (IsValid(Attacker) == true)
+	// Only works if the swing of this Mesh was registered with a valid Attacker.
+	FContinuousAttackRuntime* Runtime = FindRuntimeState(MeshComp);
+	if (Runtime != nullptr && Runtime->Attacker.IsValid() == true)
 	{
 		// Depending on the enum selected during the animation notify customization,
-		// overwrite the AttackProperties with the intended socket names. 
+		// overwrite this swing's socket names with the intended ones, leaving the shared AttackProperties untouched. 
 		switch (AttackFromHand)
 		{
 		case ESolHandAttack::LEFT:
-			AttackProperties.StartBoneName = LeftWeaponStart;
-			AttackProperties.EndBoneName = LeftWeaponEnd;
+			Runtime->StartBoneName = LeftWeaponStart;
+			Runtime->EndBoneName = LeftWeaponEnd;
 			break;
 		case ESolHandAttack::RIGHT:
-			AttackProperties.StartBoneName = RightWeaponStart;
-			AttackProperties.EndBoneName = RightWeaponEnd;
+			Runtime->StartBoneName = RightWeaponStart;
+			Runtime->EndBoneName = RightWeaponEnd;
 			break;
 		}	
 	}
@@ -30,7 +30,7 @@ protected:
 public:
 	/**
 	 * The overridden NotifyBegin event called when the Anim Notify State has begun.
-	 * From the beginning, overwrite the names of the sockets from where to trace the attack in the Attack Parameters,
+	 * From the beginning, overwrite the names of the sockets from where to trace the attack in this Mesh's swing,
 	 * according to the AttackFromHand enum.
 	 */
 	UFUNCTION()
@@ -0,0 +1,285 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_CombatBenchmark.h"
+#include "TOAS.h"
+#include "C_EnemyCharacter.h"
+#include "C_PlayableCharacter.h"
+#include "Components/StaticMeshComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace CombatBenchmark
+{
+	// Obtains the value under which the given percent of the samples fall.
+	float Percentile(TArray<float> Samples, const float Percent)
+	{
+		if (Samples.Num() == 0)
+		{
+			return 0.0f;
+		}
+
+		Samples.Sort();
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Samples.Num() * Percent) - 1, 0, Samples.Num() - 1);
+		return Samples[Index];
+	}
+
+	// Obtains the average of the samples.
+	float Average(const TArray<float>& Samples)
+	{
+		float Total = 0.0f;
+		for (const float Sample : Samples)
+		{
+			Total += Sample;
+		}
+		return Samples.Num() > 0 ? Total / Samples.Num() : 0.0f;
+	}
+}
+
+AC_CombatBenchmark::AC_CombatBenchmark()
+{
+	// Measures after everything else in the frame has run.
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
+
+	EnemyClasses = {
+		TSoftClassPtr<AC_EnemyCharacter>(FSoftObjectPath(
+			TEXT("/Game/ThirdPerson/Blueprints/Enemies/BP_Enemy_Scarecrow.BP_Enemy_Scarecrow_C"))),
+		TSoftClassPtr<AC_EnemyCharacter>(FSoftObjectPath(
+			TEXT("/Game/ThirdPerson/Blueprints/Enemies/BP_Enemy_FlyingTester.BP_Enemy_FlyingTester_C"))),
+		TSoftClassPtr<AC_EnemyCharacter>(FSoftObjectPath(
+			TEXT("/Game/ThirdPerson/Blueprints/Enemies/BP_Enemy_0_Test.BP_Enemy_0_Test_C")))
+	};
+}
+
+void AC_CombatBenchmark::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Player = Cast<AC_PlayableCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+	if (Player.IsValid() == false || EnemyCounts.Num() == 0)
+	{
+		UE_LOG(LogTemplateCharacter, Error, TEXT("Combat Benchmark needs a playable character and enemy counts."));
+		SetActorTickEnabled(false);
+		return;
+	}
+
+	if (bGenerateArena == true)
+	{
+		GenerateArena(Player->GetActorLocation());
+	}
+
+	BeginCount();
+}
+
+void AC_CombatBenchmark::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	const double Now = FPlatformTime::Seconds();
+	const double FrameSeconds = LastTickTime > 0.0 ? Now - LastTickTime : DeltaSeconds;
+	LastTickTime = Now;
+
+	CountTime += DeltaSeconds;
+	TimeSinceAttack += DeltaSeconds;
+
+	// Attack chains keep going during the warm up as well, so measuring starts mid-combat.
+	if (AC_PlayableCharacter* PlayerCharacter = Player.Get())
+	{
+		if (TimeSinceAttack >= AttackInterval)
+		{
+			TimeSinceAttack = 0.0f;
+			PlayerCharacter->PlayScriptedAttack();
+		}
+	}
+
+	if (CountTime < WarmUpSeconds)
+	{
+		return;
+	}
+
+	FrameMs.Add(static_cast<float>(FrameSeconds * 1000.0));
+	GameThreadMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+	// The counters are published at the end of every frame, so these are the counts of the previous one.
+	const TOASCounters::FFrameCounts& LastFrame = TOASCounters::GetLastFrame();
+	AttackTraces += LastFrame.AttackTraces;
+	PerceptionTraces += LastFrame.PerceptionTraces;
+	ZTargetQueries += LastFrame.ZTargetQueries;
+	HitsResolved += LastFrame.HitsResolved;
+	DamageEvents += LastFrame.DamageEvents;
+
+	if (CountTime < WarmUpSeconds + MeasureSeconds)
+	{
+		return;
+	}
+
+	EndCount();
+
+	if (++CountIndex < EnemyCounts.Num())
+	{
+		BeginCount();
+		return;
+	}
+
+	SetActorTickEnabled(false);
+	Finish();
+}
+
+void AC_CombatBenchmark::BeginCount()
+{
+	CountTime = 0.0f;
+	TimeSinceAttack = 0.0f;
+	FrameMs.Reset();
+	GameThreadMs.Reset();
+	AttackTraces = 0;
+	PerceptionTraces = 0;
+	ZTargetQueries = 0;
+	HitsResolved = 0;
+	DamageEvents = 0;
+
+	const int32 EnemiesPerClass = EnemyCounts[CountIndex];
+	const int32 TotalEnemies = EnemiesPerClass * EnemyClasses.Num();
+	const FVector Center = Player->GetActorLocation();
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	// Enemies are spread over a sunflower spiral, so every run places them in the same spots.
+	int32 SpawnIndex = 0;
+	for (const TSoftClassPtr<AC_EnemyCharacter>& SoftClass : EnemyClasses)
+	{
+		UClass* EnemyClass = SoftClass.LoadSynchronous();
+		if (EnemyClass == nullptr)
+		{
+			UE_LOG(LogTemplateCharacter, Warning, TEXT("Combat Benchmark couldn't load %s."), *SoftClass.ToString());
+			SpawnIndex += EnemiesPerClass;
+			continue;
+		}
+
+		for (int32 Index = 0; Index < EnemiesPerClass; ++Index, ++SpawnIndex)
+		{
+			const float Distance = FMath::Lerp(MinSpawnDistance, MaxSpawnDistance,
+				FMath::Sqrt((SpawnIndex + 0.5f) / TotalEnemies));
+			const float Angle = SpawnIndex * 137.508f;
+			const FVector Offset = FRotator(0.0f, Angle, 0.0f).Vector() * Distance;
+			const FRotator FacingPlayer(0.0f, Angle + 180.0f, 0.0f);
+
+			if (AC_EnemyCharacter* Enemy = GetWorld()->SpawnActor<AC_EnemyCharacter>(EnemyClass,
+				Center + Offset, FacingPlayer, SpawnParameters))
+			{
+				SpawnedEnemies.Add(Enemy);
+			}
+		}
+	}
+}
+
+void AC_CombatBenchmark::EndCount()
+{
+	FCombatBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+	Result.EnemiesPerClass = EnemyCounts[CountIndex];
+	Result.TotalEnemies = SpawnedEnemies.Num();
+	Result.Frames = FrameMs.Num();
+	Result.AverageFrameMs = CombatBenchmark::Average(FrameMs);
+	Result.P95FrameMs = CombatBenchmark::Percentile(FrameMs, 0.95f);
+	Result.AverageGameThreadMs = CombatBenchmark::Average(GameThreadMs);
+	Result.P95GameThreadMs = CombatBenchmark::Percentile(GameThreadMs, 0.95f);
+
+	const float Frames = FMath::Max(FrameMs.Num(), 1);
+	Result.AttackTracesPerFrame = AttackTraces / Frames;
+	Result.PerceptionTracesPerFrame = PerceptionTraces / Frames;
+	Result.ZTargetQueriesPerFrame = ZTargetQueries / Frames;
+	Result.HitsResolved = HitsResolved;
+	Result.DamageEvents = DamageEvents;
+
+	UE_LOG(LogTemplateCharacter, Log, TEXT("Combat Benchmark: %d enemies, %.2f ms per frame (%.2f ms game thread)."),
+		Result.TotalEnemies, Result.AverageFrameMs, Result.AverageGameThreadMs);
+
+	for (const TWeakObjectPtr<AC_EnemyCharacter>& Enemy : SpawnedEnemies)
+	{
+		if (Enemy.IsValid() == true)
+		{
+			Enemy->Destroy();
+		}
+	}
+	SpawnedEnemies.Reset();
+}
+
+void AC_CombatBenchmark::Finish()
+{
+	TArray<TSharedPtr<FJsonValue>> JsonResults;
+	for (const FCombatBenchmarkResult& Result : Results)
+	{
+		const TSharedRef<FJsonObject> JsonResult = MakeShared<FJsonObject>();
+		JsonResult->SetNumberField(TEXT("enemies_per_class"), Result.EnemiesPerClass);
+		JsonResult->SetNumberField(TEXT("total_enemies"), Result.TotalEnemies);
+		JsonResult->SetNumberField(TEXT("frames"), Result.Frames);
+		JsonResult->SetNumberField(TEXT("avg_frame_ms"), Result.AverageFrameMs);
+		JsonResult->SetNumberField(TEXT("p95_frame_ms"), Result.P95FrameMs);
+		JsonResult->SetNumberField(TEXT("avg_game_thread_ms"), Result.AverageGameThreadMs);
+		JsonResult->SetNumberField(TEXT("p95_game_thread_ms"), Result.P95GameThreadMs);
+		JsonResult->SetNumberField(TEXT("attack_traces_per_frame"), Result.AttackTracesPerFrame);
+		JsonResult->SetNumberField(TEXT("perception_traces_per_frame"), Result.PerceptionTracesPerFrame);
+		JsonResult->SetNumberField(TEXT("ztarget_queries_per_frame"), Result.ZTargetQueriesPerFrame);
+		JsonResult->SetNumberField(TEXT("hits_resolved"), Result.HitsResolved);
+		JsonResult->SetNumberField(TEXT("damage_events"), Result.DamageEvents);
+		JsonResults.Add(MakeShared<FJsonValueObject>(JsonResult));
+	}
+
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("map"), GetWorld()->GetMapName());
+	Root->SetStringField(TEXT("date"), FDateTime::Now().ToIso8601());
+	Root->SetArrayField(TEXT("results"), JsonResults);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Root, Writer);
+
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("Benchmarks")
+		/ FString::Printf(TEXT("CombatBenchmark_%s.json"), *FDateTime::Now().ToString());
+	if (FFileHelper::SaveStringToFile(Json, *FilePath))
+	{
+		UE_LOG(LogTemplateCharacter, Log, TEXT("Combat Benchmark results written to %s."), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogTemplateCharacter, Error, TEXT("Combat Benchmark couldn't write %s."), *FilePath);
+	}
+
+	if (bQuitWhenDone == true)
+	{
+		UKismetSystemLibrary::QuitGame(this, nullptr, EQuitPreference::Quit, false);
+	}
+}
+
+void AC_CombatBenchmark::GenerateArena(const FVector& Center)
+{
+	UStaticMesh* PlaneMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Plane.Plane"));
+	if (PlaneMesh == nullptr)
+	{
+		return;
+	}
+
+	// The floor goes right under the player's feet.
+	const FVector FloorLocation = Center - FVector(0.0f, 0.0f, Player->GetDefaultHalfHeight());
+
+	AStaticMeshActor* Floor = GetWorld()->SpawnActor<AStaticMeshActor>(FloorLocation, FRotator::ZeroRotator);
+	if (Floor == nullptr)
+	{
+		return;
+	}
+
+	Floor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+	Floor->GetStaticMeshComponent()->SetStaticMesh(PlaneMesh);
+	// The plane measures 100 units per side; it reaches a little further than the farthest enemy.
+	Floor->SetActorScale3D(FVector(MaxSpawnDistance * 2.5f / 100.0f, MaxSpawnDistance * 2.5f / 100.0f, 1.0f));
+}
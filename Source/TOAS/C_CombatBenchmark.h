@@ -0,0 +1,165 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "C_CombatBenchmark.generated.h"
+
+class AC_EnemyCharacter;
+class AC_PlayableCharacter;
+
+// Measurements of a single enemy count, written to the results file.
+USTRUCT(BlueprintType)
+struct FCombatBenchmarkResult
+{
+	GENERATED_BODY()
+
+	// Enemies spawned of each class.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Benchmark")
+	int32 EnemiesPerClass = 0;
+
+	// Enemies spawned in total.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Benchmark")
+	int32 TotalEnemies = 0;
+
+	// Frames measured.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Benchmark")
+	int32 Frames = 0;
+
+	// Average and 95th percentile of the frame time, in milliseconds.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Benchmark")
+	float AverageFrameMs = 0.0f;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Benchmark")
+	float P95FrameMs = 0.0f;
+
+	// Average and 95th percentile of the game thread time, in milliseconds.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Benchmark")
+	float AverageGameThreadMs = 0.0f;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Benchmark")
+	float P95GameThreadMs = 0.0f;
+
+	// Average amount per frame of attack sweeps, perception traces and Z-Target searches.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Benchmark")
+	float AttackTracesPerFrame = 0.0f;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Benchmark")
+	float PerceptionTracesPerFrame = 0.0f;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Benchmark")
+	float ZTargetQueriesPerFrame = 0.0f;
+
+	// Total amount of hits resolved and damage applied.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Benchmark")
+	int32 HitsResolved = 0;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Benchmark")
+	int32 DamageEvents = 0;
+};
+
+/**
+ * Actor that measures how combat scales with the amount of enemies.
+ * For every count in EnemyCounts, it spawns that many enemies of each class around the player, drives the player's
+ * attack chains, records frame time, game thread time and trace counts per frame, and moves on to the next count.
+ * Once done, the results are written as JSON into Saved/Benchmarks.
+ * Spawned by the Game Mode when the game is launched with -CombatBenchmark, which also quits once done.
+ */
+UCLASS()
+class TOAS_API AC_CombatBenchmark : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AC_CombatBenchmark();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	// Sets whether the game quits once the results are written; only has effect before Begin Play.
+	FORCEINLINE void SetQuitWhenDone(const bool bQuit) { bQuitWhenDone = bQuit; }
+
+	// Returns the results of the counts measured so far.
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Benchmark")
+	const TArray<FCombatBenchmarkResult>& GetResults() const { return Results; }
+
+protected:
+	virtual void BeginPlay() override;
+
+	// Enemy classes to spawn; each count spawns this many enemies of every class.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (AllowPrivateAccess = "true"))
+	TArray<TSoftClassPtr<AC_EnemyCharacter>> EnemyClasses;
+
+	// Amount of enemies of each class to measure, in order.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (AllowPrivateAccess = "true"))
+	TArray<int32> EnemyCounts = { 10, 50, 200, 500 };
+
+	// Seconds waited after spawning, so enemies land and settle before measuring.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (AllowPrivateAccess = "true"))
+	float WarmUpSeconds = 2.0f;
+
+	// Seconds measured for each count.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (AllowPrivateAccess = "true"))
+	float MeasureSeconds = 10.0f;
+
+	// Seconds between scripted attacks of the player.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (AllowPrivateAccess = "true"))
+	float AttackInterval = 0.25f;
+
+	// Enemies are spawned in rings around the player, between these distances.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (AllowPrivateAccess = "true"))
+	float MinSpawnDistance = 300.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (AllowPrivateAccess = "true"))
+	float MaxSpawnDistance = 4000.0f;
+
+	// If true, a flat floor big enough for every enemy is generated under the player.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (AllowPrivateAccess = "true"))
+	bool bGenerateArena = true;
+
+	// If true, the game quits once the results are written.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (AllowPrivateAccess = "true"))
+	bool bQuitWhenDone = false;
+
+private:
+	// Spawns the enemies of the current count and starts warming up.
+	void BeginCount();
+
+	// Summarizes the frames of the current count and destroys its enemies.
+	void EndCount();
+
+	// Writes every result as JSON and quits if asked to.
+	void Finish();
+
+	// Spawns a flat floor under the player.
+	void GenerateArena(const FVector& Center);
+
+	// Player whose attack chains are driven.
+	TWeakObjectPtr<AC_PlayableCharacter> Player;
+
+	// Enemies spawned for the current count.
+	TArray<TWeakObjectPtr<AC_EnemyCharacter>> SpawnedEnemies;
+
+	// Per frame measurements of the current count.
+	TArray<float> FrameMs;
+	TArray<float> GameThreadMs;
+
+	// Counter totals of the current count.
+	int64 AttackTraces = 0;
+	int64 PerceptionTraces = 0;
+	int64 ZTargetQueries = 0;
+	int32 HitsResolved = 0;
+	int32 DamageEvents = 0;
+
+	// Results of every count measured.
+	TArray<FCombatBenchmarkResult> Results;
+
+	// Index in EnemyCounts of the count being measured.
+	int32 CountIndex = 0;
+
+	// Seconds since the current count began, including the warm up.
+	float CountTime = 0.0f;
+
+	// Seconds since the last scripted attack.
+	float TimeSinceAttack = 0.0f;
+
+	// Wall clock time of the previous tick; frame times are measured with it, since a fixed timestep
+	// makes DeltaSeconds the same every frame.
+	double LastTickTime = 0.0;
+};
@@ -4,50 +4,149 @@
 
 
 #include "C_EnemyCharacter.h"
+#include "TOAS.h"
+#include "C_AComp_SocketCache.h"
+#include "C_WS_EnemyPerception.h"
+#include "C_WS_EnemySignificance.h"
 
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
 
+DECLARE_CYCLE_STAT(TEXT("Trace For Player"), STAT_TOAS_TraceForPlayer, STATGROUP_TOAS);
+
 AC_EnemyCharacter::AC_EnemyCharacter()
 {
 	bIsEnemy = true;
+
+	// Default tiers: full rate up close, then slower ticks and animation the further the enemy is.
+	FSignificanceTier NearTier;
+	NearTier.MaxDistance = 1500.0f;
+	SignificanceTiers.Add(NearTier);
+
+	FSignificanceTier MidTier;
+	MidTier.MaxDistance = 4000.0f;
+	MidTier.ActorTickInterval = 0.1f;
+	MidTier.MovementTickInterval = 0.05f;
+	MidTier.bUseUpdateRateOptimizations = true;
+	MidTier.AnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+	SignificanceTiers.Add(MidTier);
+
+	FSignificanceTier FarTier;
+	FarTier.MaxDistance = 8000.0f;
+	FarTier.ActorTickInterval = 0.5f;
+	FarTier.MovementTickInterval = 0.2f;
+	FarTier.bUseUpdateRateOptimizations = true;
+	FarTier.AnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	SignificanceTiers.Add(FarTier);
+}
+
+void AC_EnemyCharacter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// The eyes of the enemy are read every frame, so they are resolved once here.
+	SightOriginHandle = GetSocketCache()->RegisterSocket(SightOrigin);
+
+	// Looking for the player is handed over to the Enemy Perception subsystem whenever there is one.
+	Perception = GetWorld()->GetSubsystem<UC_WS_EnemyPerception>();
+	if (Perception != nullptr)
+	{
+		Perception->RegisterEnemy(this);
+	}
+
+	if (UC_WS_EnemySignificance* Significance = GetWorld()->GetSubsystem<UC_WS_EnemySignificance>())
+	{
+		Significance->RegisterEnemy(this);
+	}
+}
+
+void AC_EnemyCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (Perception != nullptr)
+	{
+		Perception->UnregisterEnemy(this);
+		Perception = nullptr;
+	}
+
+	if (UC_WS_EnemySignificance* Significance = GetWorld()->GetSubsystem<UC_WS_EnemySignificance>())
+	{
+		Significance->UnregisterEnemy(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AC_EnemyCharacter::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
-	TraceForPlayer();
+	// Without the Enemy Perception subsystem, the enemy keeps tracing for the player on its own.
+	if (Perception == nullptr || Perception->IsRegistered(this) == false)
+	{
+		TraceForPlayer();
+	}
+}
+
+bool AC_EnemyCharacter::GetSightTransform(FTransform& OutTransform) const
+{
+	return GetSocketCache()->GetSocketTransform(SightOriginHandle, OutTransform);
+}
+
+void AC_EnemyCharacter::SetSignificanceTier(const int32 TierIndex)
+{
+	if (TierIndex == CurrentSignificanceTier || SignificanceTiers.IsValidIndex(TierIndex) == false)
+	{
+		return;
+	}
+
+	CurrentSignificanceTier = TierIndex;
+	ApplySignificanceTier(SignificanceTiers[TierIndex]);
+}
+
+void AC_EnemyCharacter::NotifyPlayerFound()
+{
+	if (bPlayerWasFound == true)
+	{
+		return;
+	}
+
+	bPlayerWasFound = true;
+	OnPlayerWasFound.Broadcast();
 }
 
 void AC_EnemyCharacter::TraceForPlayer()
 {
+	TOAS_SCOPE(TraceForPlayer);
+
 	if (bPlayerWasFound == true)
 	{
 		return;
 	}
 	
-	if (GetMesh()->DoesSocketExist(SightOrigin) == false)
+	// Location and Rotation of the head come from a single cached transform.
+	FTransform HeadTransform;
+	if (GetSightTransform(HeadTransform) == false)
 	{
 		return;
 	}
 
-	FVector HeadLocation = GetMesh()->GetSocketLocation(SightOrigin);
+	FVector HeadLocation = HeadTransform.GetLocation();
 
-	FRotator HeadRotation = GetMesh()->GetSocketRotation(SightOrigin);
+	FRotator HeadRotation = HeadTransform.Rotator();
 
 	FVector FwdLocation = UKismetMathLibrary::GetForwardVector(HeadRotation) * SightDistance;
 
 	FHitResult Hit;
+	++TOASCounters::PerceptionTraces;
 	
-	bPlayerWasFound = UKismetSystemLibrary::SphereTraceSingleForObjects(this, HeadLocation + FwdLocation,
+	const bool bFound = UKismetSystemLibrary::SphereTraceSingleForObjects(this, HeadLocation + FwdLocation,
 		HeadLocation + FwdLocation, SightRadius, SightTargetType, false,
-		{}, EDrawDebugTrace::ForOneFrame, Hit, true);
+		{}, DebugTraceEnum, Hit, true);
 
-	if (bPlayerWasFound == true)
+	if (bFound == true)
 	{
-		OnPlayerWasFound.Broadcast();
+		NotifyPlayerFound();
 	}
 		
 }
@@ -6,9 +6,11 @@
 
 #include "CoreMinimal.h"
 #include "TOASCharacter.h"
+#include "C_StructsAndEnums.h"
 #include "C_EnemyCharacter.generated.h"
 
 class UPawnSensingComponent;
+class UC_WS_EnemyPerception;
 
 /**
  * 
@@ -72,11 +74,63 @@ protected:
 		meta = (AllowPrivateAccess = "true"))
 	TArray<TEnumAsByte<EObjectTypeQuery>> SightTargetType;
 
+	// If true, the player must also be visible from the SightOrigin (nothing blocking in between) to be found.
+	// Off by default, matching the original overlap-only sight; enable it per enemy Blueprint.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy_Settings",
+		meta = (AllowPrivateAccess = "true"))
+	bool bSightNeedsLineOfSight = false;
+
+	// Handle of the SightOrigin socket in the Socket Cache.
+	int32 SightOriginHandle = INDEX_NONE;
+
+	// Index of this enemy in the arrays of the Enemy Perception subsystem; INDEX_NONE while not registered.
+	int32 PerceptionIndex = INDEX_NONE;
+
+	// Enemy Perception subsystem of the world, resolved once in BeginPlay; null if the world has none.
+	UPROPERTY(Transient)
+	TObjectPtr<UC_WS_EnemyPerception> Perception;
+
+	// Update settings per significance, from most to least significant, applied by the Enemy Significance subsystem.
+	// Tune them per enemy Blueprint; an empty array keeps the enemy at full rate.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy_Significance",
+		meta = (AllowPrivateAccess = "true"))
+	TArray<FSignificanceTier> SignificanceTiers;
+
+	// Index of the Significance Tier currently applied; INDEX_NONE until the first evaluation.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Enemy_Significance",
+		meta = (AllowPrivateAccess = "true"))
+	int32 CurrentSignificanceTier = INDEX_NONE;
+
 public:
 	AC_EnemyCharacter();
 
 	virtual void Tick(float DeltaSeconds) override;
 
+	// Getters of the sight values, used by the Enemy Perception subsystem.
+	FORCEINLINE float GetSightDistance() const { return SightDistance; }
+	FORCEINLINE float GetSightRadius() const { return SightRadius; }
+	FORCEINLINE bool NeedsLineOfSight() const { return bSightNeedsLineOfSight; }
+	FORCEINLINE bool HasFoundPlayer() const { return bPlayerWasFound; }
+	FORCEINLINE int32 GetPerceptionIndex() const { return PerceptionIndex; }
+	FORCEINLINE void SetPerceptionIndex(const int32 Index) { PerceptionIndex = Index; }
+
+	// Getters of the significance values, used by the Enemy Significance subsystem.
+	FORCEINLINE const TArray<FSignificanceTier>& GetSignificanceTiers() const { return SignificanceTiers; }
+	FORCEINLINE int32 GetSignificanceTier() const { return CurrentSignificanceTier; }
+
+	// Applies the Significance Tier at the given index, if it isn't applied already.
+	void SetSignificanceTier(const int32 TierIndex);
+
+	// Obtains the cached world transform of the SightOrigin socket. Returns false if the socket doesn't exist.
+	bool GetSightTransform(FTransform& OutTransform) const;
+
+	// Marks the player as found and lets Blueprints know about it.
+	void NotifyPlayerFound();
+
 protected:
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	void TraceForPlayer();
 };
@@ -4,18 +4,26 @@
 
 
 #include "C_GI_GameManager.h"
+#include "C_AComp_Stats.h"
+#include "C_SaveFile.h"
+#include "C_WB_SaveProcess.h"
+#include "TOASCharacter.h"
+#include "Async/Async.h"
+#include "Kismet/GameplayStatics.h"
+#include "Serialization/MemoryWriter.h"
+#include "TimerManager.h"
 
 void UC_GI_GameManager::UpdateChallengeOnSaveData(const FString& ChallengeID, const bool& bSuccess)
 {
-	// If there is no SaveGameObject instance being referenced to read from and write to,
-	// do not proceed into the function.
+	// If there is no ID to write to, do not proceed into the function.
 	if (ChallengeID == "")
 	{
 		return;
 	}
 
-	// Otherwise, update the found Challenge's success boolean through the FString Key.
-	SaveData.ChallengesList.Add(ChallengeID, bSuccess);
+	// Otherwise, intern the Challenge and update its success flag.
+	UpdateProgressOnSaveData(EProgressCategory::CHALLENGE,
+		InternProgressID(EProgressCategory::CHALLENGE, FName(*ChallengeID)), bSuccess);
 }
 
 void UC_GI_GameManager::GetChallengeCompletionOnSaveData(const FString& ChallengeID, bool& bSuccess)
@@ -23,74 +31,455 @@ void UC_GI_GameManager::GetChallengeCompletionOnSaveData(const FString& Challeng
 	// Start by defaulting the bSuccess reference to false.
 	bSuccess = false;
 
-	// If there is no SaveGameObject instance being referenced to read from,
-	// do not proceed into the function.
-	if (ChallengeID == "" || SaveData.ChallengesList.Contains(ChallengeID) == false)
+	// If there is no ID to read from, do not proceed into the function.
+	if (ChallengeID == "")
 	{
 		return;
 	}
 
-	// Otherwise, check if the Challenge List contains the respective Challenge
-	// to see it was already completed in this save file.
-	bSuccess = SaveData.ChallengesList[ChallengeID];
+	// Otherwise, look the ID up without adding it to the name table;
+	// unknown IDs were never completed in this save file.
+	const FProgressFlags& Flags = SaveData.GetFlags(EProgressCategory::CHALLENGE);
+	bSuccess = Flags.IsSet(Flags.Find(FName(*ChallengeID, FNAME_Find)));
 }
 
 void UC_GI_GameManager::UpdateCutsceneOnSaveData(const FString& CutsceneID, const bool& bWasPlayed)
 {
-	// If there is no SaveGameObject instance being referenced to read from and write to,
-	// do not proceed into the function.
+	// If there is no ID to write to, do not proceed into the function.
 	if (CutsceneID == "")
 	{
 		return;
 	}
 
-	// Otherwise, update the found Cutscene that is done being played through the FString Key.
-	SaveData.CutsceneList.Add(CutsceneID, bWasPlayed);
+	// Otherwise, intern the Cutscene and update whether it is done being played.
+	UpdateProgressOnSaveData(EProgressCategory::CUTSCENE,
+		InternProgressID(EProgressCategory::CUTSCENE, FName(*CutsceneID)), bWasPlayed);
 }
 
 void UC_GI_GameManager::GetCutsceneCompletionOnSaveData(const FString& CutsceneID, bool& bWasPlayed)
 {
-	// Start by defaulting the bSuccess reference to false.
+	// Start by defaulting the bWasPlayed reference to false.
 	bWasPlayed = false;
 
-	// If there is no SaveGameObject instance being referenced to read from,
-	// do not proceed into the function.
-	if (CutsceneID == "" || SaveData.CutsceneList.Contains(CutsceneID) == false)
+	// If there is no ID to read from, do not proceed into the function.
+	if (CutsceneID == "")
 	{
 		return;
 	}
 
-	// Otherwise, check if the Challenge List contains the respective Challenge
-	// to see it was already completed in this save file.
-	bWasPlayed = SaveData.CutsceneList[CutsceneID];
+	// Otherwise, look the ID up without adding it to the name table;
+	// unknown IDs were never played in this save file.
+	const FProgressFlags& Flags = SaveData.GetFlags(EProgressCategory::CUTSCENE);
+	bWasPlayed = Flags.IsSet(Flags.Find(FName(*CutsceneID, FNAME_Find)));
 }
 
 void UC_GI_GameManager::UpdateDialogueOnSaveData(const FString& DialogueID, const bool& bWasPlayed)
 {
-	// If there is no SaveGameObject instance being referenced to read from and write to,
-	// do not proceed into the function.
+	// If there is no ID to write to, do not proceed into the function.
 	if (DialogueID == "")
 	{
 		return;
 	}
 
-	// Otherwise, update the found Cutscene that is done being played through the FString Key.
-	SaveData.DialogueTriggersList.Add(DialogueID, bWasPlayed);
+	// Otherwise, intern the Dialogue Trigger and update whether it is done being played.
+	UpdateProgressOnSaveData(EProgressCategory::DIALOGUE,
+		InternProgressID(EProgressCategory::DIALOGUE, FName(*DialogueID)), bWasPlayed);
 }
 
 void UC_GI_GameManager::GetDialogueCompletionOnSaveData(const FString& DialogueID, bool& bWasPlayed)
 {
-	// Start by defaulting the bSuccess reference to false.
+	// Start by defaulting the bWasPlayed reference to false.
 	bWasPlayed = false;
 
-	// If there is no SaveGameObject instance being referenced to read from,
-	// do not proceed into the function.
-	if (DialogueID == "" || SaveData.DialogueTriggersList.Contains(DialogueID) == false)
+	// If there is no ID to read from, do not proceed into the function.
+	if (DialogueID == "")
+	{
+		return;
+	}
+
+	// Otherwise, look the ID up without adding it to the name table;
+	// unknown IDs were never played in this save file.
+	const FProgressFlags& Flags = SaveData.GetFlags(EProgressCategory::DIALOGUE);
+	bWasPlayed = Flags.IsSet(Flags.Find(FName(*DialogueID, FNAME_Find)));
+}
+
+void UC_GI_GameManager::ResolveProgressOnSaveData(const EProgressCategory Category, const TArray<FName>& IDs,
+	TArray<int32>& OutIndices, TArray<bool>& OutCompleted)
+{
+	OutIndices.SetNumUninitialized(IDs.Num());
+	OutCompleted.SetNumUninitialized(IDs.Num());
+
+	for (int32 Entry = 0; Entry < IDs.Num(); ++Entry)
+	{
+		OutIndices[Entry] = InternProgressID(Category, IDs[Entry]);
+		OutCompleted[Entry] = SaveData.GetFlags(Category).IsSet(OutIndices[Entry]);
+	}
+}
+
+bool UC_GI_GameManager::IsProgressCompletedOnSaveData(const EProgressCategory Category, const int32 Index)
+{
+	return SaveData.GetFlags(Category).IsSet(Index);
+}
+
+void UC_GI_GameManager::UpdateProgressOnSaveData(const EProgressCategory Category, const int32 Index,
+	const bool bCompleted)
+{
+	FProgressFlags& Flags = SaveData.GetFlags(Category);
+	if (Flags.IDs.IsValidIndex(Index) == false)
+	{
+		return;
+	}
+
+	FSaveJournalRecord Record;
+	Record.Category = Category;
+	Record.ID = Flags.IDs[Index];
+	Record.bCompleted = bCompleted;
+
+	// The Save Data is about to be replaced by the one being loaded, so the change waits to be applied over it.
+	if (bLoadProcessRunning == true)
+	{
+		UpdatesDuringLoad.Add(MoveTemp(Record));
+		return;
+	}
+
+	// Only actual changes reach the journal.
+	if (Flags.IsSet(Index) == bCompleted)
+	{
+		return;
+	}
+
+	Flags.Set(Index, bCompleted);
+	JournalRecord(MoveTemp(Record));
+}
+
+int32 UC_GI_GameManager::InternProgressID(const EProgressCategory Category, const FName ID)
+{
+	// Interning alone isn't journaled; completion records name their ID, so replaying them interns it.
+	return SaveData.GetFlags(Category).Intern(ID);
+}
+
+void UC_GI_GameManager::ApplyUpdatesDuringLoad()
+{
+	TArray<FSaveJournalRecord> Updates = MoveTemp(UpdatesDuringLoad);
+	UpdatesDuringLoad.Reset();
+
+	for (const FSaveJournalRecord& Update : Updates)
+	{
+		UpdateProgressOnSaveData(Update.Category, InternProgressID(Update.Category, Update.ID), Update.bCompleted);
+	}
+}
+
+void UC_GI_GameManager::JournalRecord(FSaveJournalRecord&& Record)
+{
+	// Until the game is saved or loaded there is no slot to journal into; the first save includes every change.
+	if (CurrentSlotName.IsEmpty() == true)
+	{
+		return;
+	}
+
+	Record.Sequence = ++LastJournalSequence;
+	FMemoryWriter Writer(JournalBuffer, false, true);
+	TOASSaveFile::WriteJournalRecord(Writer, Record);
+
+	// Long sessions eventually fold their journal into a full save, so loading never replays too much.
+	if (++JournalRecordsSinceSave >= JournalRecordsBeforeSave && bSaveProcessRunning == false)
+	{
+		SaveGameToSlot(CurrentSlotName, nullptr);
+		return;
+	}
+
+	if (GetTimerManager().IsTimerActive(JournalFlushTimer) == false)
+	{
+		GetTimerManager().SetTimer(JournalFlushTimer, this, &UC_GI_GameManager::FlushJournal, JournalFlushDelay, false);
+	}
+}
+
+void UC_GI_GameManager::FlushJournal()
+{
+	GetTimerManager().ClearTimer(JournalFlushTimer);
+
+	if (JournalBuffer.Num() == 0 || CurrentSlotName.IsEmpty() == true)
+	{
+		return;
+	}
+
+	LastFileOperation = FileOperations.Launch(TEXT("AppendSaveJournal"),
+		[Path = TOASSaveFile::GetJournalPath(CurrentSlotName), Bytes = MoveTemp(JournalBuffer)]()
+		{
+			TOASSaveFile::AppendToFile(Path, Bytes);
+		});
+	JournalBuffer.Reset();
+}
+
+void UC_GI_GameManager::Init()
+{
+	Super::Init();
+
+	PlayTimeCountedAt = FPlatformTime::Seconds();
+}
+
+void UC_GI_GameManager::LoadComplete(const float LoadTime, const FString& MapName)
+{
+	Super::LoadComplete(LoadTime, MapName);
+
+	bLastZoneSet = false;
+}
+
+void UC_GI_GameManager::StartNewGame()
+{
+	// Changes buffered for the slot being left still belong to it.
+	FlushJournal();
+
+	SaveData = FSaveData();
+	CurrentSlotName.Reset();
+	LastJournalSequence = 0;
+	JournalRecordsSinceSave = 0;
+	bLastZoneSet = false;
+
+	// Time spent in menus before starting doesn't count as played.
+	PlayTimeCountedAt = FPlatformTime::Seconds();
+}
+
+void UC_GI_GameManager::Shutdown()
+{
+	FlushJournal();
+	LastFileOperation.Wait();
+
+	Super::Shutdown();
+}
+
+void UC_GI_GameManager::SaveGameToSlot(const FString& SlotName, UC_WB_SaveProcess* ProcessWidget)
+{
+	if (SlotName.IsEmpty() == true)
 	{
 		return;
 	}
 
-	// Otherwise, check if the Challenge List contains the respective Challenge
-	// to see it was already completed in this save file.
-	bWasPlayed = SaveData.DialogueTriggersList[DialogueID];
-}
\ No newline at end of file
+	// The Save Data is replaced once the load is done, so a snapshot taken now would be stale.
+	if (bLoadProcessRunning == true)
+	{
+		UE_LOG(LogTemplateCharacter, Warning, TEXT("Couldn't save slot %s while a load runs."), *SlotName);
+		return;
+	}
+
+	// Lists from older saves are moved into the flags before the snapshot, so they are never written again.
+	for (uint8 Category = 0; Category < static_cast<uint8>(EProgressCategory::MAX); ++Category)
+	{
+		SaveData.GetFlags(static_cast<EProgressCategory>(Category));
+	}
+
+	// The header block of the slot shows the play time and zone, so both are brought up to date.
+	CountPlayTime();
+	if (bLastZoneSet == false)
+	{
+		SaveData.LastZone = FName(UGameplayStatics::GetCurrentLevelName(this, true));
+	}
+
+	// The stats of the player character are taken as they are right now.
+	const ATOASCharacter* Player = Cast<ATOASCharacter>(UGameplayStatics::GetPlayerCharacter(this, 0));
+	if (Player != nullptr && Player->GetStats() != nullptr)
+	{
+		Player->GetStats()->ExportStats(SaveData.PlayerStats);
+	}
+
+	if (ProcessWidget != nullptr)
+	{
+		ProcessWidget->ShowSavingIcon();
+	}
+
+	// Switching slots leaves the changes buffered so far in the journal of the previous one.
+	// A journal left by a session that didn't load the new slot doesn't belong to this save, so it's dropped whole.
+	uint32 CompactUpTo = LastJournalSequence;
+	if (SlotName != CurrentSlotName)
+	{
+		FlushJournal();
+		CurrentSlotName = SlotName;
+		CompactUpTo = MAX_uint32;
+	}
+
+	// The snapshot includes every change journaled so far, so the buffered ones don't need to be written.
+	SaveData.JournalSequence = LastJournalSequence;
+	JournalBuffer.Reset();
+	JournalRecordsSinceSave = 0;
+	GetTimerManager().ClearTimer(JournalFlushTimer);
+
+	if (bSaveProcessRunning == true)
+	{
+		// Checkpoints reached in a burst only write their latest state.
+		if (bHasPendingSave == true && PendingProcessWidget.IsValid() == true
+			&& PendingProcessWidget.Get() != ProcessWidget)
+		{
+			PendingProcessWidget->CompleteProcessAndRelease();
+		}
+		PendingCompactUpTo = bHasPendingSave == true ? FMath::Max(PendingCompactUpTo, CompactUpTo) : CompactUpTo;
+		bHasPendingSave = true;
+		PendingSlotName = SlotName;
+		PendingSaveData = SaveData;
+		PendingProcessWidget = ProcessWidget;
+		return;
+	}
+
+	FSaveData Snapshot = SaveData;
+	StartSave(SlotName, MoveTemp(Snapshot), CompactUpTo, ProcessWidget);
+}
+
+void UC_GI_GameManager::LoadGameFromSlot(const FString& SlotName, UC_WB_SaveProcess* ProcessWidget)
+{
+	if (SlotName.IsEmpty() == true)
+	{
+		UE_LOG(LogTemplateCharacter, Warning, TEXT("Couldn't load a slot without a name."));
+		return;
+	}
+
+	if (bSaveProcessRunning == true)
+	{
+		UE_LOG(LogTemplateCharacter, Warning, TEXT("Couldn't load slot %s while another save process runs."),
+			*SlotName);
+		return;
+	}
+
+	if (ProcessWidget != nullptr)
+	{
+		ProcessWidget->ShowLoadingIcon();
+	}
+
+	// Changes of the slot being left are written before its journal could be read back.
+	FlushJournal();
+
+	bSaveProcessRunning = true;
+	bLoadProcessRunning = true;
+
+	TWeakObjectPtr<UC_GI_GameManager> WeakThis(this);
+	TWeakObjectPtr<UC_WB_SaveProcess> WeakWidget(ProcessWidget);
+	const FString Path = TOASSaveFile::GetSlotPath(SlotName);
+	const FString JournalPath = TOASSaveFile::GetJournalPath(SlotName);
+
+	LastFileOperation = FileOperations.Launch(TEXT("LoadGameFromSlot"),
+		[WeakThis, WeakWidget, SlotName, Path, JournalPath]()
+	{
+		TSharedRef<FSaveData> Loaded = MakeShared<FSaveData>();
+		const bool bSuccess = TOASSaveFile::Load(Path, *Loaded);
+
+		// Changes made since the last full save are replayed over it.
+		const uint32 SavedSequence = Loaded->JournalSequence;
+		const bool bReplayed = bSuccess == true && TOASSaveFile::ReplayJournal(JournalPath, *Loaded) > SavedSequence;
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, WeakWidget, SlotName, Loaded, bSuccess, bReplayed]()
+		{
+			if (UC_GI_GameManager* GameManager = WeakThis.Get())
+			{
+				if (bSuccess == true)
+				{
+					GameManager->SaveData = MoveTemp(*Loaded);
+					GameManager->CurrentSlotName = SlotName;
+					GameManager->LastJournalSequence = GameManager->SaveData.JournalSequence;
+					GameManager->JournalBuffer.Reset();
+					GameManager->JournalRecordsSinceSave = 0;
+					GameManager->PlayTimeCountedAt = FPlatformTime::Seconds();
+					GameManager->bLastZoneSet = false;
+
+					// A player character spawned later on takes the stats from its Stats Component instead.
+					const ATOASCharacter* Player =
+						Cast<ATOASCharacter>(UGameplayStatics::GetPlayerCharacter(GameManager, 0));
+					if (Player != nullptr && Player->GetStats() != nullptr)
+					{
+						Player->GetStats()->ImportStats(GameManager->SaveData.PlayerStats);
+					}
+				}
+				GameManager->FinishSaveProcess(false, bSuccess, WeakWidget.Get());
+				GameManager->ApplyUpdatesDuringLoad();
+
+				// The replayed journal is folded into a new full save, which then empties it.
+				if (bReplayed == true)
+				{
+					GameManager->SaveGameToSlot(SlotName, nullptr);
+				}
+			}
+		});
+	});
+}
+
+void UC_GI_GameManager::EnumerateSaveSlots()
+{
+	TWeakObjectPtr<UC_GI_GameManager> WeakThis(this);
+
+	UE::Tasks::Launch(TEXT("EnumerateSaveSlots"), [WeakThis]()
+	{
+		TArray<FSaveSlotHeader> Slots = TOASSaveFile::ReadSlotHeaders(TOASSaveFile::FindSlotNames());
+		Slots.Sort([](const FSaveSlotHeader& A, const FSaveSlotHeader& B) { return A.SavedAt > B.SavedAt; });
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Slots = MoveTemp(Slots)]()
+		{
+			if (UC_GI_GameManager* GameManager = WeakThis.Get())
+			{
+				GameManager->OnSaveSlotsEnumerated.Broadcast(Slots);
+			}
+		});
+	});
+}
+
+void UC_GI_GameManager::CountPlayTime()
+{
+	const double Now = FPlatformTime::Seconds();
+	SaveData.PlayTime += Now - PlayTimeCountedAt;
+	PlayTimeCountedAt = Now;
+}
+
+void UC_GI_GameManager::StartSave(const FString& SlotName, FSaveData&& Snapshot, const uint32 CompactUpTo,
+	UC_WB_SaveProcess* ProcessWidget)
+{
+	bSaveProcessRunning = true;
+
+	TWeakObjectPtr<UC_GI_GameManager> WeakThis(this);
+	TWeakObjectPtr<UC_WB_SaveProcess> WeakWidget(ProcessWidget);
+	const FString Path = TOASSaveFile::GetSlotPath(SlotName);
+	const FString JournalPath = TOASSaveFile::GetJournalPath(SlotName);
+
+	LastFileOperation = FileOperations.Launch(TEXT("SaveGameToSlot"),
+		[WeakThis, WeakWidget, Path, JournalPath, CompactUpTo, Snapshot = MoveTemp(Snapshot)]()
+	{
+		const bool bSuccess = TOASSaveFile::WriteAtomically(Path, TOASSaveFile::Encode(Snapshot));
+
+		// The journal is only emptied once the save that includes its changes is safely written.
+		if (bSuccess == true)
+		{
+			TOASSaveFile::CompactJournal(JournalPath, CompactUpTo);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, WeakWidget, bSuccess]()
+		{
+			if (UC_GI_GameManager* GameManager = WeakThis.Get())
+			{
+				GameManager->FinishSaveProcess(true, bSuccess, WeakWidget.Get());
+			}
+		});
+	});
+}
+
+void UC_GI_GameManager::FinishSaveProcess(const bool bWasSaving, const bool bSuccess,
+	UC_WB_SaveProcess* ProcessWidget)
+{
+	bSaveProcessRunning = false;
+	bLoadProcessRunning = false;
+
+	if (bSuccess == false)
+	{
+		UE_LOG(LogTemplateCharacter, Error, TEXT("Save process failed while %s."),
+			bWasSaving == true ? TEXT("saving") : TEXT("loading"));
+	}
+
+	if (ProcessWidget != nullptr)
+	{
+		ProcessWidget->CompleteProcessAndRelease();
+	}
+
+	OnSaveProcessFinished.Broadcast(bWasSaving, bSuccess);
+
+	if (bHasPendingSave == true)
+	{
+		bHasPendingSave = false;
+		StartSave(PendingSlotName, MoveTemp(PendingSaveData), PendingCompactUpTo, PendingProcessWidget.Get());
+		PendingSaveData = FSaveData();
+		PendingProcessWidget.Reset();
+	}
+}
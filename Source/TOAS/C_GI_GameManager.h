@@ -6,11 +6,24 @@
 
 #include "CoreMinimal.h"
 #include "C_StructsAndEnums.h"
+#include "C_SaveFile.h"
 #include "Engine/GameInstance.h"
+#include "Tasks/Pipe.h"
 #include "C_GI_GameManager.generated.h"
 
+class UC_WB_SaveProcess;
+
+// Delegation of the end of a save or load process.
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSaveProcessFinished, bool, bWasSaving, bool, bSuccess);
+
+// Delegation of the save slots found by EnumerateSaveSlots.
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSaveSlotsEnumerated, const TArray<FSaveSlotHeader>&, Slots);
+
 /**
- * 
+ * Game Instance that keeps the Save Data and the settings that last between levels.
+ * Saving and loading happen on background threads; the game thread only copies the Save Data.
  */
 
 UCLASS()
@@ -24,6 +37,14 @@ protected:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="DATA")
 	EPromptControl PromptControl = EPromptControl::PC;
+
+	// Seconds changes wait in memory before being appended to the journal, so bursts of them share one write.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="DATA", meta=(ClampMin=0))
+	float JournalFlushDelay = 2.0f;
+
+	// Changes journaled since the last full save after which the slot is saved again, emptying its journal.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="DATA", meta=(ClampMin=1))
+	int32 JournalRecordsBeforeSave = 256;
 	
 public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "DATA_Getters")
@@ -49,4 +70,156 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "SaveData_Functions")
 	void GetDialogueCompletionOnSaveData(const FString& DialogueID, bool& bSuccess);
+
+	/**
+	 * Interns a batch of progress IDs and resolves their completion in a single call, meant for Begin Play.
+	 * The returned indices stay valid for this save, so later queries and updates skip the IDs altogether.
+	 * @param Category Kind of progress the IDs belong to.
+	 * @param IDs IDs to resolve.
+	 * @param OutIndices Index of each ID, in the same order; INDEX_NONE for empty IDs.
+	 * @param OutCompleted Completion of each ID, in the same order.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveData_Functions")
+	void ResolveProgressOnSaveData(const EProgressCategory Category, const TArray<FName>& IDs,
+		TArray<int32>& OutIndices, TArray<bool>& OutCompleted);
+
+	// Checks the completion of a progress index obtained from ResolveProgressOnSaveData.
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "SaveData_Functions")
+	bool IsProgressCompletedOnSaveData(const EProgressCategory Category, const int32 Index);
+
+	// Updates the completion of a progress index obtained from ResolveProgressOnSaveData.
+	// Updates made while a load runs are queued and applied over the loaded Save Data.
+	UFUNCTION(BlueprintCallable, Category = "SaveData_Functions")
+	void UpdateProgressOnSaveData(const EProgressCategory Category, const int32 Index, const bool bCompleted);
+
+	/**
+	 * Saves a snapshot of the Save Data into a slot. Laying it out into uncompressed sections with their own checksums
+	 * and writing them happen on a background thread, and the file is replaced atomically, so the frame never waits
+	 * and a crash never corrupts the slot.
+	 * Saving while another save is running keeps only the latest snapshot, written once the running one is done.
+	 * Ignored while a load is running, since the Save Data is about to be replaced.
+	 * @param SlotName Name of the slot to save into.
+	 * @param ProcessWidget Optional widget that shows the Saving Icon until the save is done.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveData_Functions")
+	void SaveGameToSlot(const FString& SlotName, UC_WB_SaveProcess* ProcessWidget);
+
+	/**
+	 * Loads the Save Data of a slot. Mapping the file, checking the checksums of its sections and reading them
+	 * happen on a background thread, and the Save Data is replaced on the game thread once done.
+	 * A file failing its checksums loads nothing. Ignored while another process is running.
+	 * @param SlotName Name of the slot to load from.
+	 * @param ProcessWidget Optional widget that shows the Loading Icon until the load is done.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveData_Functions")
+	void LoadGameFromSlot(const FString& SlotName, UC_WB_SaveProcess* ProcessWidget);
+
+	// Checks whether a save or load process is running.
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "SaveData_Functions")
+	bool IsSaveProcessRunning() const { return bSaveProcessRunning; }
+
+	// Delegate for calling out to when a save or load process is done.
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FSaveProcessFinished OnSaveProcessFinished;
+
+	/**
+	 * Lists every save slot by reading only the small header block of each file, in parallel, off the game thread.
+	 * The slots are broadcast through OnSaveSlotsEnumerated, most recently saved first.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveData_Functions")
+	void EnumerateSaveSlots();
+
+	// Delegate for calling out to when the save slots are listed.
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FSaveSlotsEnumerated OnSaveSlotsEnumerated;
+
+	// Getter of the player stats kept by the Save Data; empty until the game is saved or loaded.
+	const FSavedStats& GetSavedPlayerStats() const { return SaveData.PlayerStats; }
+
+	// Sets the zone shown for this Save Data in slot lists; the name of the current level is used otherwise.
+	UFUNCTION(BlueprintCallable, Category = "SaveData_Functions")
+	void SetLastZone(const FName Zone) { SaveData.LastZone = Zone; bLastZoneSet = true; }
+
+	/**
+	 * Replaces the Save Data with a fresh one for a new game, and starts counting its play time.
+	 * Changes made from now on aren't journaled until the new game is saved into a slot.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveData_Functions")
+	void StartNewGame();
+
+	// Starts counting play time.
+	virtual void Init() override;
+
+	// Forgets the zone set on the previous level, so saves fall back to the name of the new one.
+	virtual void LoadComplete(const float LoadTime, const FString& MapName) override;
+
+	// Writes the journaled changes still in memory and waits for every file operation before shutting down.
+	virtual void Shutdown() override;
+
+private:
+	// Interns a progress ID without journaling it.
+	int32 InternProgressID(const EProgressCategory Category, const FName ID);
+
+	// Applies the progress updates queued while a load ran, journaling them; the load may have failed.
+	void ApplyUpdatesDuringLoad();
+
+	// Buffers a change for the journal of the current slot, and schedules writing it.
+	void JournalRecord(FSaveJournalRecord&& Record);
+
+	// Appends the buffered changes to the journal of the current slot on a background thread.
+	void FlushJournal();
+
+	// Begins writing a snapshot of the Save Data on a background thread,
+	// then removes the journal records up to CompactUpTo.
+	void StartSave(const FString& SlotName, FSaveData&& Snapshot, const uint32 CompactUpTo,
+		UC_WB_SaveProcess* ProcessWidget);
+
+	// Adds the time played since it was last counted to the Save Data.
+	void CountPlayTime();
+
+	// Ends a process on the game thread, releasing its widget and starting the pending save, if any.
+	void FinishSaveProcess(const bool bWasSaving, const bool bSuccess, UC_WB_SaveProcess* ProcessWidget);
+
+	// Whether a save or load process is running.
+	bool bSaveProcessRunning = false;
+
+	// Whether the running process is a load.
+	bool bLoadProcessRunning = false;
+
+	// Progress updates made while a load runs, applied once it's done.
+	TArray<FSaveJournalRecord> UpdatesDuringLoad;
+
+	// Time play time was last counted at.
+	double PlayTimeCountedAt = 0.0;
+
+	// Whether a zone manager set the LastZone on the current level; saves use the level name otherwise.
+	bool bLastZoneSet = false;
+
+	// Save requested while another process was running; only the latest one is kept.
+	bool bHasPendingSave = false;
+	FString PendingSlotName;
+	FSaveData PendingSaveData;
+	uint32 PendingCompactUpTo = 0;
+	TWeakObjectPtr<UC_WB_SaveProcess> PendingProcessWidget;
+
+	// Slot last saved into or loaded from; changes are only journaled once there is one.
+	FString CurrentSlotName;
+
+	// Changes waiting to be appended to the journal.
+	TArray<uint8> JournalBuffer;
+
+	// Sequence of the last journaled change.
+	uint32 LastJournalSequence = 0;
+
+	// Changes journaled since the last full save.
+	int32 JournalRecordsSinceSave = 0;
+
+	// Timer that appends the buffered changes once the burst is over.
+	FTimerHandle JournalFlushTimer;
+
+	// Runs every file operation in order, one at a time, off the game thread.
+	UE::Tasks::FPipe FileOperations{ TEXT("TOASSaveFiles") };
+
+	// Last file operation launched, waited for when shutting down.
+	UE::Tasks::FTask LastFileOperation;
 };
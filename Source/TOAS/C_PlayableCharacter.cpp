@@ -4,17 +4,31 @@
 
 
 #include "C_PlayableCharacter.h"
+#include "TOAS.h"
 
 #include "C_AComp_Stats.h"
+#include "C_AComp_AudioPool.h"
+#include "C_AComp_InputRecorder.h"
+#include "C_AComp_SocketCache.h"
+#include "C_AComp_WallProbe.h"
+#include "C_WS_TargetRegistry.h"
+#include "C_WB_LockOnPresenter.h"
+#include "Animation/AnimInstance.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
+#include "Engine/World.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "Kismet/GameplayStatics.h"
+#include "GameFramework/PlayerController.h"
 #include "Kismet/KismetMathLibrary.h"
-#include "Kismet/KismetSystemLibrary.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+
+DECLARE_CYCLE_STAT(TEXT("Wall Slide Manager"), STAT_TOAS_WallSlideManager, STATGROUP_TOAS);
+DECLARE_CYCLE_STAT(TEXT("Trace For Z-Target"), STAT_TOAS_TraceForZTarget, STATGROUP_TOAS);
+DECLARE_CYCLE_STAT(TEXT("Fixed Camera Rotation Manager"), STAT_TOAS_FixedCameraRotationManager, STATGROUP_TOAS);
+DECLARE_CYCLE_STAT(TEXT("Trace The Step For Sound"), STAT_TOAS_TraceTheStepForSound, STATGROUP_TOAS);
 
 
 AC_PlayableCharacter::AC_PlayableCharacter()
@@ -30,6 +44,18 @@ AC_PlayableCharacter::AC_PlayableCharacter()
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
 	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
 
+	// Create the Actor Component that plays footsteps through a pool of reusable Audio Components.
+	FootstepAudioPool = CreateDefaultSubobject<UC_AComp_AudioPool>(TEXT("FootstepAudioPool"));
+
+	// Create the Actor Component that records and replays the player's input for performance captures.
+	InputRecorderComponent = CreateDefaultSubobject<UC_AComp_InputRecorder>(TEXT("InputRecorder"));
+
+	// Create the Actor Component that probes for walls to slide on.
+	WallProbeComponent = CreateDefaultSubobject<UC_AComp_WallProbe>(TEXT("WallProbe"));
+
+	// The Z-Targeting indicators are drawn on the player's screen instead of by Widget Components on every character.
+	LockOnPresenterClass = UC_WB_LockOnPresenter::StaticClass();
+
 	// Note: The skeletal mesh and anim blueprint references on the Mesh component (inherited from Character) 
 	// are set in the derived blueprint asset named ThirdPersonCharacter (to avoid direct content references in C++)
 }
@@ -60,14 +86,32 @@ void AC_PlayableCharacter::BeginPlay()
 	bCanDoAttacks = true;
 	bCanDodge = true;
 	AttackCount = 0;
-
-	
 }
 
 void AC_PlayableCharacter::NotifyControllerChanged()
 {
 	Super::NotifyControllerChanged();
 
+	// The presenter belongs to the player controlling this character, so it's replaced along with the controller;
+	// a character left behind on respawn takes its presenter off the screen.
+	if (LockOnPresenter != nullptr)
+	{
+		LockOnPresenter->RemoveFromParent();
+		LockOnPresenter = nullptr;
+	}
+
+	// Z-Targeting indicators are drawn by a single presenter on the player's screen.
+	if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
+	{
+		if (LockOnPresenterClass != nullptr && PlayerController->IsLocalController() == true)
+		{
+			LockOnPresenter = CreateWidget<UC_WB_LockOnPresenter>(PlayerController, LockOnPresenterClass,
+				FName("LockOnPresenter"));
+			LockOnPresenter->SetTrackingCharacter(this);
+			LockOnPresenter->AddToPlayerScreen();
+		}
+	}
+
 	// Add Input Mapping Context
 	if (const APlayerController* PlayerController = Cast<APlayerController>(Controller))
 	{
@@ -93,6 +137,10 @@ void AC_PlayableCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInpu
 		EnhancedInputComponent->BindAction(SprintAction, ETriggerEvent::Triggered, this, &AC_PlayableCharacter::SprintActStart);
 		EnhancedInputComponent->BindAction(SprintAction, ETriggerEvent::Canceled, this, &AC_PlayableCharacter::SprintActEnd);
 		EnhancedInputComponent->BindAction(SprintAction, ETriggerEvent::Completed, this, &AC_PlayableCharacter::SprintActEnd);
+
+		// The Input Recorder keeps track of these actions, along with the ones handled in Blueprints.
+		InputRecorderComponent->BindActions(EnhancedInputComponent, { MoveAction, LookAction, SprintAction, JumpAction },
+			DefaultMappingContext);
 	}
 	else
 	{
@@ -251,6 +299,48 @@ void AC_PlayableCharacter::AttackChainManager(EAttackType &Branches)
 	}
 }
 
+EAttackType AC_PlayableCharacter::PlayScriptedAttack()
+{
+	EAttackType Branches;
+	AttackChainManager(Branches);
+
+	UAnimMontage* Montage = nullptr;
+	switch (Branches)
+	{
+	case EAttackType::Ground:
+		Montage = AttackMontage;
+		break;
+	case EAttackType::Air:
+		Montage = AttackAirMontage;
+		break;
+	case EAttackType::SaveAttack:
+		// Just like the player pressing attack mid-chain, the next attack of the chain is saved.
+		bSaveTheAttack = true;
+		break;
+	default:
+		break;
+	}
+
+	// Just like the attack input, the character is attacking until the montage is done,
+	// so the next calls continue the chain instead of restarting its first attack.
+	if (Montage != nullptr && PlayAnimMontage(Montage) > 0.0f)
+	{
+		bIsAttacking = true;
+
+		FOnMontageEnded EndedDelegate;
+		EndedDelegate.BindUObject(this, &AC_PlayableCharacter::OnScriptedAttackEnded);
+		GetMesh()->GetAnimInstance()->Montage_SetEndDelegate(EndedDelegate, Montage);
+	}
+
+	return Branches;
+}
+
+void AC_PlayableCharacter::OnScriptedAttackEnded(UAnimMontage* Montage, bool bInterrupted)
+{
+	bIsAttacking = false;
+	bSaveTheAttack = false;
+}
+
 void AC_PlayableCharacter::RotateCharacterIfNotTargeting()
 {
 	// As long as there are no characters to ZTarget or See,
@@ -287,6 +377,8 @@ void AC_PlayableCharacter::RotateCharacterToWall(const FVector& WallHitLocation)
 
 void AC_PlayableCharacter::WallSlideManager()
 {
+	TOAS_SCOPE(WallSlideManager);
+
 	// Checks if character can slide down a wall if it's not on the ground AND the player is pushing the joystick.
 	bCanDoWallSlide = GetCharacterMovement()->IsMovingOnGround() == false && StickMagnitude > StickDeadZone;
 
@@ -294,18 +386,12 @@ void AC_PlayableCharacter::WallSlideManager()
 	if (bCanDoWallSlide == false || bIsHurt == true || bIsAttacking == true || bJustWallJumped == true
 	|| GetController() == nullptr)
 	{
-		// and if the character was Wall Sliding previously,
-		if (bIsWallSliding == true)
-		{
-			// then mark it as not sliding anymore.
-			bIsWallSliding = false;
-		}
+		// then forget about any wall the character was facing, marking it as not sliding anymore.
+		WallProbeComponent->ClearContact();
+		bIsWallSliding = false;
 		// As long as the character is unable to Wall Slide, stop all further code execution.
 		return;
 	}
-
-	// Creates an FHitResult variable to store important variables for wall detection.
-	FHitResult Hit;
 	
 	// Creates a Vector variable setting how far and forward should the Trace reach
 	// according to the current Player Controller Rotation.
@@ -317,28 +403,18 @@ void AC_PlayableCharacter::WallSlideManager()
 
 	FVector TraceDistance = (FwdAimingTrace * StickVector.Y) + (SideAimingTrace * StickVector.X);
 
-	// Creates a Vector variable setting how high (or low when subtracting) the Trace should be.
-	FVector UpOffset;
-	GetActorUpDistance(55.0f, UpOffset);
+	// The Wall Probe traces the upper and lower parts of the character's body asynchronously,
+	// only when the character moved or turned enough since the last probe.
+	WallProbeComponent->Probe(GetActorLocation(), TraceDistance, 55.0f, ObjTypeWallSlide);
 
-	// Creates a boolean to detect if the upper part of the character's body is facing a wall.
-	bool UpperBodyTrace = UKismetSystemLibrary::LineTraceSingleForObjects(this, GetActorLocation() + UpOffset,
-		GetActorLocation() + TraceDistance + UpOffset, ObjTypeWallSlide, false, {},
-		DebugTraceEnum, Hit, true);
-
-	// Creates a boolean to detect if the lower part of the character's body is facing a wall.
-	bool LowerBodyTrace = UKismetSystemLibrary::LineTraceSingleForObjects(this, GetActorLocation() - UpOffset,
-		GetActorLocation() + TraceDistance - UpOffset, ObjTypeWallSlide, false, {},
-		DebugTraceEnum, Hit, true);
-
-	// Confirm that the character is Wall Sliding when both conditions apply.
-	bIsWallSliding = UpperBodyTrace && LowerBodyTrace;
+	// Confirm that the character is Wall Sliding when both parts of the body are facing a wall.
+	bIsWallSliding = WallProbeComponent->HasWallContact();
 		
 	// If it's confirmed that character is Wall Sliding,
 	if (bIsWallSliding == true)
 	{
 		// Make character rotate towards the normal hit position of the wall.
-		RotateCharacterToWall(Hit.Normal);
+		RotateCharacterToWall(WallProbeComponent->GetWallNormal());
 		// Modify the X and Y velocity of the character, and slowdown the character's Z velocity.
 		GetCharacterMovement()->Velocity = FVector(GetCharacterMovement()->Velocity.X,
 			GetCharacterMovement()->Velocity.Y, GetCharacterMovement()->Velocity.Z * WallSlideFallMultiplier);
@@ -354,6 +430,8 @@ void AC_PlayableCharacter::WallSlideManager()
 
 void AC_PlayableCharacter::TraceForZTarget()
 {
+	TOAS_SCOPE(TraceForZTarget);
+
 	// If the character is an enemy or is locking on, stop the function immediately.
 	if (bLockOnZTarget == true)
 	{
@@ -370,9 +448,6 @@ void AC_PlayableCharacter::TraceForZTarget()
 		DistanceToSeenTarget = GetDistanceTo(SeenTarget);
 	}
 
-	// Creates the array where to register the results from the trace.
-	TArray<FHitResult> Hit;
-
 	// Creates a Rotator that works from the camera's perspective, only using the Z/Yaw value.
 	FRotator ControlZRotator = FRotator();
 	
@@ -383,170 +458,59 @@ void AC_PlayableCharacter::TraceForZTarget()
 		ControlZRotator.Roll = 0.0;
 	}
 
-	// Creates a Vector that measures the forward distance from the ControlZRotator perspective.
-	FVector OffsetVector;
-	GetForwardDistanceFromRotator(ZTraceDistance, ControlZRotator, OffsetVector);
-
-	// Creates the target location where the Trace will end. 
-	const FVector TargetLocation = GetActorLocation() + OffsetVector;
+	++TOASCounters::ZTargetQueries;
 
-	// Boolean checking if there was a hit from the Trace, using previously created variables.
-	const bool WasHit = UKismetSystemLibrary::SphereTraceMultiForObjects(this, GetTargetLocation(),
-		TargetLocation, ZTraceRadius, ObjTypePawn, false, {},
-		DebugTraceEnum, Hit, true);
+	// Ranks every living character inside the area in front of the camera's perspective,
+	// the same area the Sphere Trace used to cover, without any physics query.
+	if (UC_WS_TargetRegistry* TargetRegistry = GetWorld()->GetSubsystem<UC_WS_TargetRegistry>())
+	{
+		TargetRegistry->RankTargets(this, GetTargetLocation(), ControlZRotator.Vector(), ZTraceDistance,
+			ZTraceRadius, ZTargetCandidates);
+	}
+	else
+	{
+		ZTargetCandidates.Reset();
+	}
 
-	// If there was a hit, proceed with the following instructions.
-	if (WasHit == true)
+	// If the Target being Tracked left the area (or was defeated),
+	if (ZTargetToTrack != nullptr && ZTargetCandidates.Contains(ZTargetToTrack) == false)
 	{
-		// Check if there is a Target already being tracked.
-		if (ZTargetToTrack != nullptr)
-		{
-			// IF there are more than 1 characters being Traced,
-			if (Hit.Num() > 1)
-			{
-				// If the Tracked Target is not the same as the first actor in the array of results,
-				// do the following to make said first actor the Seen Target. 
-				if (ZTargetToTrack != Hit[0].GetActor())
-				{
-					// If the Seen Target is not the same as the first actor in the array as well,
-					if (SeenTarget != Hit[0].GetActor())
-					{
-						// and if there is already another Target being Seen,
-						if (SeenTarget != nullptr)
-						{
-							// make it Unseen.
-							SeenTarget->IsUnseen();
-						}
-
-						// Cast the first actor in the array as the Seen Target.
-						SeenTarget = Cast<ATOASCharacter>(Hit[0].GetActor());
-
-						// If the cast was a success and there is a valid character in the variable,
-						if (SeenTarget != nullptr)
-						{
-							// and if said character's HP is greater than 0,
-							if (SeenTarget->GetStats()->GetCurrentHP() > 0)
-							{
-								// mark it as Seen.
-								SeenTarget->IsSeen();
-							}
-						}
-					}
-
-					// Once done, stop code execution.
-					return;
-				}
-
-				// Now, if the Seen Target is not the same as the second actor in the array,
-				if (SeenTarget != Hit[1].GetActor())
-				{
-					// if there was already a Seen Target,
-					if (SeenTarget != nullptr)
-					{
-						// mark it as unseen.
-						SeenTarget->IsUnseen();
-					}
-
-					// Cast the second actor as the Seen Target.
-					SeenTarget = Cast<ATOASCharacter>(Hit[1].GetActor());
-
-					// If the cast was a success,
-					if (SeenTarget != nullptr)
-					{
-						// and if the character's HP is greater than 0,
-						if (SeenTarget->GetStats()->GetCurrentHP() > 0)
-						{
-							// mark it as Seen.
-							SeenTarget->IsSeen();
-						}
-					}
-
-					// Once done, stop code execution.
-					return;
-				}
-			}
-			// However, if the number of traced actors in the array is only one, it means that there should not be
-			// another Target to be Seen.
-			else
-			{
-				// If there is a valid Seen Target,
-				if (SeenTarget != nullptr)
-				{
-					// mark it as unseen,
-					SeenTarget->IsUnseen();
-					// and empty its reference.
-					SeenTarget = nullptr;
-				}
-			}
-
-			// Check on each character traced and make sure if the currently Target being Tracked,
-			for (FHitResult& HitResult : Hit)
-			{
-				// if said Target is the same as the Actor traced,
-				if (ZTargetToTrack == HitResult.GetActor())
-				{
-					// stop further code execution.
-					return;
-				}
-			}
-			// Otherwise, if the Target is not found within the array,
-			// then mark it as Unseen, and therefore not targeted.
-			ZTargetToTrack->IsUnseen();
-			// Also, remove the target's reference from the variable.
-			ZTargetToTrack = nullptr;
-			return;
-		}
+		// mark it as Unseen, and therefore not targeted,
+		ZTargetToTrack->IsUnseen();
+		// and remove its reference from the variable.
+		ZTargetToTrack = nullptr;
+	}
 
-		// Otherwise, if there is no Locked Target, and
-		// if the Seen Target is not the same as the first traced actor in the array,
-		// then do the following to make said traced actor the Seen Target.
-		if (SeenTarget != Hit[0].GetActor())
+	// The best ranked candidate that isn't already being Tracked becomes the Seen Target.
+	ATOASCharacter* NewSeenTarget = nullptr;
+	for (ATOASCharacter* Candidate : ZTargetCandidates)
+	{
+		if (Candidate != ZTargetToTrack)
 		{
-			// If there was already another Seen Target,
-			if (SeenTarget != nullptr)
-			{
-				// mark it as Unseen.
-				SeenTarget->IsUnseen();
-			}
-
-			// Cast the first actor of the array as the Seen Target.
-			SeenTarget = Cast<ATOASCharacter>(Hit[0].GetActor());
-
-			// If the cast was a success,
-			if (SeenTarget != nullptr)
-			{
-				// and if the Seen Target is greater than 0,
-				if (SeenTarget->GetStats()->GetCurrentHP() > 0)
-				{
-					// mark it as Seen.
-					SeenTarget->IsSeen();
-				}
-			}
-
-			// Once that is done, stop further code execution.
-			return;
+			NewSeenTarget = Candidate;
+			break;
 		}
+	}
 
-		// As long as the Trace detects a hit, stop further code execution.
+	// If the Seen Target didn't change, stop further code execution.
+	if (SeenTarget == NewSeenTarget)
+	{
 		return;
 	}
 
-	// From now on, no actor is detected through the Trace.
-	// If there was previously a detected Seen Target,
+	// If there was already another Seen Target,
 	if (SeenTarget != nullptr)
 	{
-		// mark it as Unseen,
+		// mark it as Unseen.
 		SeenTarget->IsUnseen();
-		// and remove its reference from the variable.
-		SeenTarget = nullptr;
 	}
-	// If there was a Target being Tracked,
-	if (ZTargetToTrack != nullptr)
+
+	SeenTarget = NewSeenTarget;
+
+	// Only living characters are ranked, so the new Seen Target can be marked right away.
+	if (SeenTarget != nullptr)
 	{
-		// mark it as Unseen, and therefor, untracked. 
-		ZTargetToTrack->IsUnseen();
-		// and then remove its reference from the variable.
-		ZTargetToTrack = nullptr;
+		SeenTarget->IsSeen();
 	}
 }
 
@@ -589,6 +553,8 @@ void AC_PlayableCharacter::ObtainZTargetOrCamera(EZTargetResult& OutResult)
 
 void AC_PlayableCharacter::FixedCameraRotationManager(const float &DeltaSeconds)
 {
+	TOAS_SCOPE(FixedCameraRotationManager);
+
 	// Only when the perspective must be locked,
 	if (bIsLockedPerspective == true)
 	{
@@ -678,50 +644,98 @@ void AC_PlayableCharacter::ReturnToTheExpectedSpeed()
 void AC_PlayableCharacter::TraceTheStepForSound(const FName& SocketFoot, const float TraceRadius,
 	const float OverrideSoundVolume)
 {
-	if (GetMesh()->DoesSocketExist(SocketFoot))
+	TOAS_SCOPE(TraceTheStepForSound);
+
+	FTransform SocketTransform;
+	if (GetSocketCache()->GetSocketTransformByName(SocketFoot, SocketTransform) == false)
+	{
+		return;
+	}
+
+	// Same settings the Kismet trace used (complex collision, ignoring this character),
+	// also asking for the Physical Material of the surface stepped on.
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TOASFootstep), true, this);
+	QueryParams.bReturnPhysicalMaterial = true;
+
+	FHitResult Hit;
+	const FVector SocketLocation = SocketTransform.GetLocation();
+	const bool STEP = GetWorld()->SweepSingleByChannel(Hit, SocketLocation, SocketLocation, FQuat::Identity,
+		ECC_Visibility, FCollisionShape::MakeSphere(TraceRadius), QueryParams);
+
+	if (STEP == false)
+	{
+		return;
+	}
+
+	// Floors without a Physical Material of their own are tagged with their surface instead.
+	EPhysicalSurface Surface = UPhysicalMaterial::DetermineSurfaceType(Hit.PhysMaterial.Get());
+	if (Surface == SurfaceType_Default)
+	{
+		Surface = GetTaggedSurface(Hit.GetComponent());
+	}
+
+	// Surfaces without a sound stay silent.
+	FootstepAudioPool->PlaySoundAtLocation(GetStepSound(Surface), SocketLocation, OverrideSoundVolume);
+}
+
+USoundBase* AC_PlayableCharacter::GetStepSound(const EPhysicalSurface Surface) const
+{
+	// Surface Types set in the Project's Physics Settings.
+	switch (Surface)
 	{
-		FHitResult Hit;
-		FVector SocketLocation = GetMesh()->GetSocketLocation(SocketFoot);
-		bool STEP = UKismetSystemLibrary::SphereTraceSingle(this, SocketLocation,
-			SocketLocation, TraceRadius, TraceTypeQuery1, true, {},
-			DebugTraceEnum, Hit, true);
+	case SURFACE_DIRT:
+		return Step_Dirt;
+	case SURFACE_MARBLE:
+		return Step_Marble;
+	case SURFACE_METAL:
+		return Step_Metal;
+	case SURFACE_WOOD:
+		return Step_Wood;
+	case SURFACE_SAND:
+		return Step_Sand;
+	default:
+		return nullptr;
+	}
+}
+
+EPhysicalSurface AC_PlayableCharacter::GetTaggedSurface(const UPrimitiveComponent* SteppedComponent)
+{
+	if (SteppedComponent == nullptr)
+	{
+		return SurfaceType_Default;
+	}
 
-		if (STEP == true)
+	const TObjectKey<UPrimitiveComponent> Key(SteppedComponent);
+	if (const EPhysicalSurface* Cached = TaggedSurfaces.Find(Key))
+	{
+		return *Cached;
+	}
+
+	EPhysicalSurface Surface = SurfaceType_Default;
+	if (const AActor* SteppedActor = SteppedComponent->GetOwner())
+	{
+		if (SteppedActor->ActorHasTag(FName("Dirt")))
+		{
+			Surface = SURFACE_DIRT;
+		}
+		else if (SteppedActor->ActorHasTag(FName("Marble")))
+		{
+			Surface = SURFACE_MARBLE;
+		}
+		else if (SteppedActor->ActorHasTag(FName("Metal")))
+		{
+			Surface = SURFACE_METAL;
+		}
+		else if (SteppedActor->ActorHasTag(FName("Wood")))
 		{
-			if (Hit.GetActor()->ActorHasTag(FName("Dirt")))
-			{
-				UGameplayStatics::SpawnSoundAtLocation(this, Step_Dirt, SocketLocation,
-					GetActorRotation(), OverrideSoundVolume);
-				return;
-			}
-
-			if (Hit.GetActor()->ActorHasTag(FName("Marble")))
-			{
-				UGameplayStatics::SpawnSoundAtLocation(this, Step_Marble, SocketLocation,
-					GetActorRotation(), OverrideSoundVolume);
-				return;
-			}
-			
-			if (Hit.GetActor()->ActorHasTag(FName("Metal")))
-			{
-				UGameplayStatics::SpawnSoundAtLocation(this, Step_Metal, SocketLocation,
-					GetActorRotation(), OverrideSoundVolume);
-				return;
-			}
-
-			if (Hit.GetActor()->ActorHasTag(FName("Wood")))
-			{
-				UGameplayStatics::SpawnSoundAtLocation(this, Step_Wood, SocketLocation,
-					GetActorRotation(), OverrideSoundVolume);
-				return;
-			}
-
-			if (Hit.GetActor()->ActorHasTag(FName("Sand")))
-			{
-				UGameplayStatics::SpawnSoundAtLocation(this, Step_Sand, SocketLocation,
-					GetActorRotation(), OverrideSoundVolume);
-				return;
-			}
+			Surface = SURFACE_WOOD;
+		}
+		else if (SteppedActor->ActorHasTag(FName("Sand")))
+		{
+			Surface = SURFACE_SAND;
 		}
 	}
+
+	TaggedSurfaces.Add(Key, Surface);
+	return Surface;
 }
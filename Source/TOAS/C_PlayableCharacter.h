@@ -6,6 +6,7 @@
 
 #include "CoreMinimal.h"
 #include "TOASCharacter.h"
+#include "Chaos/ChaosEngineInterface.h"
 #include "C_PlayableCharacter.generated.h"
 
 class USpringArmComponent;
@@ -13,8 +14,19 @@ class UCameraComponent;
 class UInputMappingContext;
 class UInputAction;
 class USoundBase;
+class UC_WB_LockOnPresenter;
+class UC_AComp_WallProbe;
+class UC_AComp_AudioPool;
+class UC_AComp_InputRecorder;
 struct FInputActionValue;
 
+// Surface Types set in the Project's Physics Settings, used to pick the sound of each step.
+#define SURFACE_DIRT SurfaceType1
+#define SURFACE_MARBLE SurfaceType2
+#define SURFACE_METAL SurfaceType3
+#define SURFACE_WOOD SurfaceType4
+#define SURFACE_SAND SurfaceType5
+
 // Enum used to verify if Z Targeting managed to locate it's Seen Target in Blueprint customization.
 UENUM(BlueprintType)
 enum class EZTargetResult : uint8
@@ -72,6 +84,20 @@ protected:
 	// Distance to the currently Seen Target.
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "PC_ControlValues", meta = (AllowPrivateAccess = "true"))
 	float DistanceToSeenTarget;
+
+	// Widget drawing the Seen and Lock-On indicators on screen; created for the player controlling this character.
+	// Defaults to the presenter itself, which creates WB_Seen and WB_LockOn as its markers.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PerspectiveProperties", meta = (AllowPrivateAccess = "true"))
+	TSubclassOf<UC_WB_LockOnPresenter> LockOnPresenterClass;
+
+	// Instance of the Lock-On Presenter on the player's screen.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PerspectiveProperties", meta = (AllowPrivateAccess = "true"))
+	UC_WB_LockOnPresenter* LockOnPresenter;
+
+	// Characters ranked by the Target Registry during the last search, from best to worst.
+	// Refilled every time, so it's kept around only to avoid allocating each frame.
+	UPROPERTY(Transient)
+	TArray<ATOASCharacter*> ZTargetCandidates;
 	
 	// Offset to change the perspective of the camera when locking onto a target; Up or Down.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PerspectiveProperties", meta = (AllowPrivateAccess = "true"))
@@ -250,6 +276,19 @@ protected:
 		meta = (AllowPrivateAccess = "true"))
 	USoundBase* Step_Sand;
 
+	/**
+	 * Picks the step sound of a surface when it's stepped on, so changes to the Step sounds apply right away.
+	 * @return Null if the surface has no step sound.
+	 */
+	USoundBase* GetStepSound(const EPhysicalSurface Surface) const;
+
+	// Finds the surface of a floor without a Physical Material from the tags of its Actor (Dirt, Marble, ...).
+	// The tags are only looked up the first time the component is stepped on.
+	EPhysicalSurface GetTaggedSurface(const UPrimitiveComponent* SteppedComponent);
+
+	// Surface found from the tags of each component stepped on.
+	TMap<TObjectKey<UPrimitiveComponent>, EPhysicalSurface> TaggedSurfaces;
+
 	/* Components */
 	// Camera boom positioning the camera behind the character.
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
@@ -258,6 +297,18 @@ protected:
 	// Follow camera.
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* FollowCamera;
+
+	// Plays the footsteps through a small pool of reusable Audio Components.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character_SFX", meta = (AllowPrivateAccess = "true"))
+	UC_AComp_AudioPool* FootstepAudioPool;
+
+	// Records and replays the player's input, so performance captures can be reproduced.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	UC_AComp_InputRecorder* InputRecorderComponent;
+
+	// Probes for walls to slide on, asynchronously and only when the character moved or turned enough.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "WallSlideProperties", meta = (AllowPrivateAccess = "true"))
+	UC_AComp_WallProbe* WallProbeComponent;
 	
 	// MappingContext.
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
@@ -322,6 +373,20 @@ protected:
 	 */
 	UFUNCTION(BlueprintCallable, Category="PC_Functions", meta=(ExpandEnumAsExecs = "Branches"))
 	void AttackChainManager(EAttackType &Branches);
+
+public:
+	/**
+	 * Runs the Attack Chain Manager without player input, playing the matching attack montage,
+	 * so tools like the Combat Benchmark can drive attack chains.
+	 * Sets the same attack state as the attack input, so calls mid-attack save the next attack of the chain.
+	 * @return The branch chosen by the Attack Chain Manager.
+	 */
+	EAttackType PlayScriptedAttack();
+
+protected:
+	// Clears the attack state set by PlayScriptedAttack once its montage ends, in case no notify did.
+	void OnScriptedAttackEnded(UAnimMontage* Montage, bool bInterrupted);
+
 	
 	// Automatically rotates character to face Z Target; mostly used as support for Attacks.
 	UFUNCTION(BlueprintCallable, Category="PC_Functions")
@@ -392,5 +457,11 @@ public:
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
 	// Returns FollowCamera sub-object.
 	FORCEINLINE class UCameraComponent* GetFollowCamera() const { return FollowCamera; }
+	// Returns the Wall Probe sub-object.
+	FORCEINLINE UC_AComp_WallProbe* GetWallProbe() const { return WallProbeComponent; }
+	// Returns the character currently Seen by the Z-Targeting System.
+	FORCEINLINE ATOASCharacter* GetSeenTarget() const { return SeenTarget; }
+	// Returns the Target currently being Tracked by the Z-Targeting System.
+	FORCEINLINE ATOASCharacter* GetZTargetToTrack() const { return ZTargetToTrack; }
 
 };
\ No newline at end of file
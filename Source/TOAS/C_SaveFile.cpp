@@ -0,0 +1,679 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_SaveFile.h"
+#include "C_StructsAndEnums.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/StringBuilder.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace TOASSaveFile
+{
+	// Identifies the files written by this game.
+	constexpr uint32 Magic = 0x56534F54; // 'TOSV'
+
+	// Version of the layout written by Encode; files of any other version are rejected.
+	constexpr uint32 Version = 3;
+
+	// Sections of a file. Unknown sections are skipped, so new ones can be added without a new version.
+	constexpr uint32 SlotSectionId = 0x544F4C53; // 'SLOT'
+	constexpr uint32 ProgressSectionId = 0x474F5250; // 'PROG'
+	constexpr uint32 StatsSectionId = 0x54415453; // 'STAT'
+
+	// Files with more sections than this are taken as corrupt.
+	constexpr uint32 MaxSections = 32;
+
+	// Sections start at multiples of this, so their words are aligned in the mapped view.
+	constexpr uint32 SectionAlignment = 8;
+
+	// Size of the 'SLOT' section, and how many bytes of it the name of the last zone can take.
+	constexpr int32 SlotSectionSize = 64;
+	constexpr int32 LastZoneCapacity = 40;
+
+	// Bytes read from the start of a file to find its 'SLOT' section; Encode always places it within them.
+	constexpr int64 SlotHeaderReadSize = 1024;
+
+	// Bits of the first byte of a journal record, after the category in the lower bits.
+	constexpr uint8 JournalCompletedBit = 1 << 5;
+	constexpr uint8 JournalCategoryMask = (1 << 4) - 1;
+
+	/**
+	 * Layout of a file; every value is little-endian.
+	 * Header:  Magic, Version, SectionCount, TableCrc (checksum of the section table).
+	 * Section table: SectionCount entries of Id, Offset, Size, Crc (checksum of the section bytes).
+	 * 'SLOT':  Always first and 64 bytes long. Level (uint8), LastZoneLength (uint8), two reserved bytes,
+	 *          ChallengesCompleted (uint32), PlayTime (double), SavedAt ticks (int64), LastZone in UTF-8.
+	 * 'PROG':  JournalSequence, then for each category in order:
+	 *          IDCount, WordCount, WordCount completion words, IDCount names as a uint16 length and UTF-8 bytes.
+	 * 'STAT':  Level, MaxHP, CurrentHP, ATK, DEF (uint8), CurrentEXP (int32),
+	 *          ResistanceCount (uint8) and one uint8 per element.
+	 *          Fields appended to it later are left at their defaults when reading older files.
+	 */
+	struct FFileHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 SectionCount;
+		uint32 TableCrc;
+	};
+
+	struct FSectionEntry
+	{
+		uint32 Id;
+		uint32 Offset;
+		uint32 Size;
+		uint32 Crc;
+	};
+
+	// Temporary file written before replacing a save.
+	FString GetTempPath(const FString& Path)
+	{
+		return Path + TEXT(".tmp");
+	}
+
+	// Appends a value to the bytes of a section.
+	template<typename T>
+	void WriteValue(TArray<uint8>& Bytes, const T Value)
+	{
+		Bytes.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	// Reads values out of the bytes of a section in order, without copying anything but the values themselves.
+	// Reading past the end leaves the value untouched and marks the reader as failed.
+	struct FSectionReader
+	{
+		const uint8* Data = nullptr;
+		int64 Size = 0;
+		int64 Offset = 0;
+		bool bFailed = false;
+
+		template<typename T>
+		bool Read(T& OutValue)
+		{
+			if (Offset + static_cast<int64>(sizeof(T)) > Size)
+			{
+				bFailed = true;
+				return false;
+			}
+			FMemory::Memcpy(&OutValue, Data + Offset, sizeof(T));
+			Offset += sizeof(T);
+			return true;
+		}
+
+		// Returns a pointer to the next bytes and skips them; nullptr if there aren't that many left.
+		const uint8* Skip(const int64 Count)
+		{
+			if (Count < 0 || Offset + Count > Size)
+			{
+				bFailed = true;
+				return nullptr;
+			}
+			const uint8* Bytes = Data + Offset;
+			Offset += Count;
+			return Bytes;
+		}
+	};
+
+	const FProgressFlags& GetFlagsOf(const FSaveData& SaveData, const EProgressCategory Category)
+	{
+		return Category == EProgressCategory::DIALOGUE ? SaveData.DialogueTriggers
+			: Category == EProgressCategory::CUTSCENE ? SaveData.Cutscenes : SaveData.Challenges;
+	}
+
+	// Fills the header of a slot out of its Save Data, except for its name and the time it was saved.
+	void MakeSlotHeader(const FSaveData& SaveData, FSaveSlotHeader& OutHeader)
+	{
+		OutHeader.Level = SaveData.PlayerStats.Level;
+		OutHeader.PlayTime = SaveData.PlayTime;
+		OutHeader.LastZone = SaveData.LastZone;
+		OutHeader.ChallengesCompleted = 0;
+		for (const uint32 Word : SaveData.Challenges.CompletionBits)
+		{
+			OutHeader.ChallengesCompleted += FMath::CountBits(Word);
+		}
+	}
+
+	void WriteSlotSection(TArray<uint8>& Bytes, const FSaveData& SaveData)
+	{
+		FSaveSlotHeader Header;
+		MakeSlotHeader(SaveData, Header);
+
+		// Zone names are level names, well within the capacity; longer ones are cut.
+		TStringBuilder<128> Zone;
+		Header.LastZone.ToString(Zone);
+		const FTCHARToUTF8 UTF8(Zone.ToString(), Zone.Len());
+		const uint8 ZoneLength = static_cast<uint8>(FMath::Min(UTF8.Length(), LastZoneCapacity));
+
+		WriteValue<uint8>(Bytes, Header.Level);
+		WriteValue<uint8>(Bytes, Header.LastZone.IsNone() == true ? 0 : ZoneLength);
+		WriteValue<uint16>(Bytes, 0);
+		WriteValue<uint32>(Bytes, Header.ChallengesCompleted);
+		WriteValue<double>(Bytes, Header.PlayTime);
+		WriteValue<int64>(Bytes, FDateTime::UtcNow().GetTicks());
+		if (Header.LastZone.IsNone() == false)
+		{
+			Bytes.Append(reinterpret_cast<const uint8*>(UTF8.Get()), ZoneLength);
+		}
+		Bytes.SetNumZeroed(SlotSectionSize);
+	}
+
+	bool ReadSlotSection(FSectionReader& Reader, FSaveSlotHeader& OutHeader)
+	{
+		uint8 ZoneLength = 0;
+		uint16 Reserved = 0;
+		uint32 ChallengesCompleted = 0;
+		int64 SavedAt = 0;
+		Reader.Read(OutHeader.Level);
+		Reader.Read(ZoneLength);
+		Reader.Read(Reserved);
+		Reader.Read(ChallengesCompleted);
+		Reader.Read(OutHeader.PlayTime);
+		Reader.Read(SavedAt);
+
+		const uint8* Zone = Reader.Skip(FMath::Min<int32>(ZoneLength, LastZoneCapacity));
+		if (Reader.bFailed == true || SavedAt < 0)
+		{
+			return false;
+		}
+
+		OutHeader.ChallengesCompleted = static_cast<int32>(ChallengesCompleted);
+		OutHeader.SavedAt = FDateTime(SavedAt);
+		OutHeader.LastZone = ZoneLength > 0 ? FName(ZoneLength, reinterpret_cast<const UTF8CHAR*>(Zone)) : NAME_None;
+		return true;
+	}
+
+	void WriteProgressSection(TArray<uint8>& Bytes, const FSaveData& SaveData)
+	{
+		WriteValue<uint32>(Bytes, SaveData.JournalSequence);
+
+		TStringBuilder<128> Name;
+		for (uint8 Category = 0; Category < static_cast<uint8>(EProgressCategory::MAX); ++Category)
+		{
+			const FProgressFlags& Flags = GetFlagsOf(SaveData, static_cast<EProgressCategory>(Category));
+			WriteValue<uint32>(Bytes, Flags.IDs.Num());
+			WriteValue<uint32>(Bytes, Flags.CompletionBits.Num());
+			Bytes.Append(reinterpret_cast<const uint8*>(Flags.CompletionBits.GetData()),
+				Flags.CompletionBits.Num() * sizeof(uint32));
+
+			for (const FName ID : Flags.IDs)
+			{
+				Name.Reset();
+				ID.ToString(Name);
+				const FTCHARToUTF8 UTF8(Name.ToString(), Name.Len());
+				const uint16 Length = static_cast<uint16>(FMath::Min(UTF8.Length(), static_cast<int32>(MAX_uint16)));
+				WriteValue<uint16>(Bytes, Length);
+				Bytes.Append(reinterpret_cast<const uint8*>(UTF8.Get()), Length);
+			}
+		}
+	}
+
+	bool ReadProgressSection(FSectionReader& Reader, FSaveData& SaveData)
+	{
+		Reader.Read(SaveData.JournalSequence);
+
+		for (uint8 Category = 0; Category < static_cast<uint8>(EProgressCategory::MAX); ++Category)
+		{
+			FProgressFlags& Flags = SaveData.GetFlags(static_cast<EProgressCategory>(Category));
+			uint32 IDCount = 0;
+			uint32 WordCount = 0;
+			Reader.Read(IDCount);
+			Reader.Read(WordCount);
+
+			// Counts are checked against the bytes left before anything is allocated for them.
+			const uint8* Words = Reader.Skip(static_cast<int64>(WordCount) * sizeof(uint32));
+			if (Words == nullptr || IDCount > Reader.Size - Reader.Offset)
+			{
+				return false;
+			}
+			Flags.CompletionBits.SetNumUninitialized(WordCount);
+			FMemory::Memcpy(Flags.CompletionBits.GetData(), Words, WordCount * sizeof(uint32));
+
+			Flags.IDs.Reset(IDCount);
+			for (uint32 Index = 0; Index < IDCount; ++Index)
+			{
+				uint16 Length = 0;
+				Reader.Read(Length);
+				const uint8* Name = Reader.Skip(Length);
+				if (Name == nullptr)
+				{
+					return false;
+				}
+				Flags.IDs.Add(FName(Length, reinterpret_cast<const UTF8CHAR*>(Name)));
+			}
+			Flags.RemoveDuplicateIDs();
+		}
+
+		return Reader.bFailed == false;
+	}
+
+	void WriteStatsSection(TArray<uint8>& Bytes, const FSavedStats& Stats)
+	{
+		WriteValue<uint8>(Bytes, Stats.Level);
+		WriteValue<uint8>(Bytes, Stats.MaxHP);
+		WriteValue<uint8>(Bytes, Stats.CurrentHP);
+		WriteValue<uint8>(Bytes, Stats.ATK);
+		WriteValue<uint8>(Bytes, Stats.DEF);
+		WriteValue<int32>(Bytes, Stats.CurrentEXP);
+		WriteValue<uint8>(Bytes, ElementCount);
+		Bytes.Append(Stats.Resistances, ElementCount);
+	}
+
+	bool ReadStatsSection(FSectionReader& Reader, FSavedStats& Stats)
+	{
+		Reader.Read(Stats.Level);
+		Reader.Read(Stats.MaxHP);
+		Reader.Read(Stats.CurrentHP);
+		Reader.Read(Stats.ATK);
+		Reader.Read(Stats.DEF);
+		Reader.Read(Stats.CurrentEXP);
+
+		// Resistances of elements added after the file was written stay at ZERO.
+		uint8 ResistanceCount = 0;
+		Reader.Read(ResistanceCount);
+		if (const uint8* Resistances = Reader.Skip(ResistanceCount))
+		{
+			FMemory::Memcpy(Stats.Resistances, Resistances, FMath::Min<int32>(ResistanceCount, ElementCount));
+		}
+
+		return Reader.bFailed == false;
+	}
+
+	// Decodes the sections of a file whose magic and version were already checked.
+	bool DecodeSections(TConstArrayView<uint8> Bytes, FSaveData& SaveData)
+	{
+		FFileHeader Header;
+		FMemory::Memcpy(&Header, Bytes.GetData(), sizeof(Header));
+
+		const int64 TableSize = static_cast<int64>(Header.SectionCount) * sizeof(FSectionEntry);
+		if (Header.SectionCount > MaxSections || static_cast<int64>(sizeof(Header)) + TableSize > Bytes.Num()
+			|| FCrc::MemCrc32(Bytes.GetData() + sizeof(Header), TableSize) != Header.TableCrc)
+		{
+			return false;
+		}
+
+		bool bHasProgress = false;
+		for (uint32 Section = 0; Section < Header.SectionCount; ++Section)
+		{
+			FSectionEntry Entry;
+			FMemory::Memcpy(&Entry, Bytes.GetData() + sizeof(Header) + Section * sizeof(FSectionEntry), sizeof(Entry));
+			if (static_cast<int64>(Entry.Offset) + Entry.Size > Bytes.Num()
+				|| FCrc::MemCrc32(Bytes.GetData() + Entry.Offset, Entry.Size) != Entry.Crc)
+			{
+				return false;
+			}
+
+			FSectionReader Reader{Bytes.GetData() + Entry.Offset, Entry.Size};
+			if (Entry.Id == SlotSectionId)
+			{
+				FSaveSlotHeader SlotHeader;
+				if (ReadSlotSection(Reader, SlotHeader) == false)
+				{
+					return false;
+				}
+				SaveData.PlayTime = SlotHeader.PlayTime;
+				SaveData.LastZone = SlotHeader.LastZone;
+			}
+			else if (Entry.Id == ProgressSectionId)
+			{
+				if (ReadProgressSection(Reader, SaveData) == false)
+				{
+					return false;
+				}
+				bHasProgress = true;
+			}
+			else if (Entry.Id == StatsSectionId)
+			{
+				if (ReadStatsSection(Reader, SaveData.PlayerStats) == false)
+				{
+					return false;
+				}
+			}
+		}
+
+		return bHasProgress;
+	}
+
+	FString GetSlotDirectory()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("SaveGames");
+	}
+
+	FString GetSlotPath(const FString& SlotName)
+	{
+		return GetSlotDirectory() / SlotName + TEXT(".toassave");
+	}
+
+	TArray<FString> FindSlotNames()
+	{
+		// Slots whose save stopped right before the rename only have their temporary file.
+		TArray<FString> Files;
+		IFileManager::Get().FindFiles(Files, *(GetSlotDirectory() / TEXT("*.toassave")), true, false);
+		TArray<FString> TempFiles;
+		IFileManager::Get().FindFiles(TempFiles, *(GetSlotDirectory() / TEXT("*.toassave.tmp")), true, false);
+
+		TArray<FString> SlotNames;
+		SlotNames.Reserve(Files.Num() + TempFiles.Num());
+		for (const FString& File : Files)
+		{
+			SlotNames.AddUnique(FPaths::GetBaseFilename(File));
+		}
+		for (const FString& File : TempFiles)
+		{
+			SlotNames.AddUnique(FPaths::GetBaseFilename(FPaths::GetBaseFilename(File)));
+		}
+		return SlotNames;
+	}
+
+	// Reads the 'SLOT' section of a file out of its first bytes; false if it has none or they are corrupt.
+	bool ReadSlotHeaderFile(const FString& Path, FSaveSlotHeader& OutHeader)
+	{
+		TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Path));
+		if (Handle.IsValid() == false)
+		{
+			return false;
+		}
+
+		uint8 Bytes[SlotHeaderReadSize];
+		const int64 Size = FMath::Min(Handle->Size(), SlotHeaderReadSize);
+		if (Size < static_cast<int64>(sizeof(FFileHeader)) || Handle->Read(Bytes, Size) == false)
+		{
+			return false;
+		}
+
+		FFileHeader Header;
+		FMemory::Memcpy(&Header, Bytes, sizeof(Header));
+		const int64 TableSize = static_cast<int64>(Header.SectionCount) * sizeof(FSectionEntry);
+		if (Header.Magic != Magic || Header.Version != Version
+			|| Header.SectionCount > MaxSections || static_cast<int64>(sizeof(Header)) + TableSize > Size
+			|| FCrc::MemCrc32(Bytes + sizeof(Header), TableSize) != Header.TableCrc)
+		{
+			return false;
+		}
+
+		for (uint32 Section = 0; Section < Header.SectionCount; ++Section)
+		{
+			FSectionEntry Entry;
+			FMemory::Memcpy(&Entry, Bytes + sizeof(Header) + Section * sizeof(FSectionEntry), sizeof(Entry));
+			if (Entry.Id != SlotSectionId)
+			{
+				continue;
+			}
+			if (static_cast<int64>(Entry.Offset) + Entry.Size > Size
+				|| FCrc::MemCrc32(Bytes + Entry.Offset, Entry.Size) != Entry.Crc)
+			{
+				return false;
+			}
+
+			FSectionReader Reader{Bytes + Entry.Offset, Entry.Size};
+			return ReadSlotSection(Reader, OutHeader);
+		}
+
+		return false;
+	}
+
+	bool ReadSlotHeader(const FString& SlotName, FSaveSlotHeader& OutHeader)
+	{
+		const FString Path = GetSlotPath(SlotName);
+		OutHeader.SlotName = SlotName;
+		return ReadSlotHeaderFile(Path, OutHeader) == true || ReadSlotHeaderFile(GetTempPath(Path), OutHeader) == true;
+	}
+
+	TArray<FSaveSlotHeader> ReadSlotHeaders(const TArray<FString>& SlotNames)
+	{
+		TArray<FSaveSlotHeader> Headers;
+		Headers.SetNum(SlotNames.Num());
+		TArray<bool> bRead;
+		bRead.SetNumZeroed(SlotNames.Num());
+
+		// Each slot only costs a small read, so on slow storage the time goes into waiting for it;
+		// reading them side by side overlaps those waits.
+		ParallelFor(SlotNames.Num(), [&SlotNames, &Headers, &bRead](const int32 Index)
+		{
+			bRead[Index] = ReadSlotHeader(SlotNames[Index], Headers[Index]);
+		});
+
+		for (int32 Index = Headers.Num() - 1; Index >= 0; --Index)
+		{
+			if (bRead[Index] == false)
+			{
+				Headers.RemoveAt(Index);
+			}
+		}
+		return Headers;
+	}
+
+	TArray<uint8> Encode(const FSaveData& SaveData)
+	{
+		TArray<uint8> Slot;
+		WriteSlotSection(Slot, SaveData);
+		TArray<uint8> Progress;
+		WriteProgressSection(Progress, SaveData);
+		TArray<uint8> Stats;
+		WriteStatsSection(Stats, SaveData.PlayerStats);
+
+		const TPair<uint32, const TArray<uint8>*> Sections[] = {
+			{SlotSectionId, &Slot},
+			{ProgressSectionId, &Progress},
+			{StatsSectionId, &Stats}
+		};
+		constexpr uint32 SectionCount = UE_ARRAY_COUNT(Sections);
+
+		TArray<FSectionEntry, TInlineAllocator<SectionCount>> Table;
+		uint32 Offset = sizeof(FFileHeader) + SectionCount * sizeof(FSectionEntry);
+		for (const TPair<uint32, const TArray<uint8>*>& Section : Sections)
+		{
+			Offset = Align(Offset, SectionAlignment);
+			const TArray<uint8>& SectionBytes = *Section.Value;
+			Table.Add({Section.Key, Offset, static_cast<uint32>(SectionBytes.Num()),
+				FCrc::MemCrc32(SectionBytes.GetData(), SectionBytes.Num())});
+			Offset += SectionBytes.Num();
+		}
+
+		const FFileHeader Header{Magic, Version, SectionCount,
+			FCrc::MemCrc32(Table.GetData(), Table.Num() * sizeof(FSectionEntry))};
+
+		TArray<uint8> Bytes;
+		Bytes.SetNumZeroed(Offset);
+		FMemory::Memcpy(Bytes.GetData(), &Header, sizeof(Header));
+		FMemory::Memcpy(Bytes.GetData() + sizeof(Header), Table.GetData(), Table.Num() * sizeof(FSectionEntry));
+		for (int32 Section = 0; Section < Table.Num(); ++Section)
+		{
+			FMemory::Memcpy(Bytes.GetData() + Table[Section].Offset, Sections[Section].Value->GetData(),
+				Table[Section].Size);
+		}
+
+		return Bytes;
+	}
+
+	bool Decode(TConstArrayView<uint8> Bytes, FSaveData& OutSaveData)
+	{
+		if (Bytes.Num() < static_cast<int64>(sizeof(FFileHeader)))
+		{
+			return false;
+		}
+
+		uint32 FileMagic = 0;
+		uint32 FileVersion = 0;
+		FMemory::Memcpy(&FileMagic, Bytes.GetData(), sizeof(uint32));
+		FMemory::Memcpy(&FileVersion, Bytes.GetData() + sizeof(uint32), sizeof(uint32));
+		if (FileMagic != Magic || FileVersion != Version)
+		{
+			return false;
+		}
+
+		FSaveData SaveData;
+		if (DecodeSections(Bytes, SaveData) == false)
+		{
+			return false;
+		}
+
+		OutSaveData = MoveTemp(SaveData);
+		return true;
+	}
+
+	bool WriteAtomically(const FString& Path, const TArray<uint8>& Bytes)
+	{
+		if (Bytes.Num() == 0)
+		{
+			return false;
+		}
+
+		const FString TempPath = GetTempPath(Path);
+		if (FFileHelper::SaveArrayToFile(Bytes, *TempPath) == false)
+		{
+			return false;
+		}
+
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		if (PlatformFile.MoveFile(*Path, *TempPath) == true)
+		{
+			return true;
+		}
+
+		// Platforms whose rename can't replace an existing file need the old save removed first;
+		// Read falls back to the temporary file if the game stops right here.
+		PlatformFile.DeleteFile(*Path);
+		return PlatformFile.MoveFile(*Path, *TempPath);
+	}
+
+	bool Read(const FString& Path, TArray<uint8>& OutBytes)
+	{
+		if (FFileHelper::LoadFileToArray(OutBytes, *Path, FILEREAD_Silent) == true)
+		{
+			return true;
+		}
+		return FFileHelper::LoadFileToArray(OutBytes, *GetTempPath(Path), FILEREAD_Silent);
+	}
+
+	// Decodes a single file through a mapped view, or by reading it where files can't be mapped.
+	bool LoadFile(const FString& Path, FSaveData& OutSaveData)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		TUniquePtr<IMappedFileHandle> Handle(PlatformFile.OpenMapped(*Path));
+		if (Handle.IsValid() == true)
+		{
+			// The region has to be released before the handle it was mapped from.
+			TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(0, Handle->GetFileSize()));
+			const bool bDecoded = Region.IsValid() == true && Region->GetMappedSize() <= MAX_int32
+				&& Decode(TConstArrayView<uint8>(Region->GetMappedPtr(), static_cast<int32>(Region->GetMappedSize())),
+					OutSaveData);
+			Region.Reset();
+			return bDecoded;
+		}
+
+		TArray<uint8> Bytes;
+		return FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent) == true && Decode(Bytes, OutSaveData);
+	}
+
+	bool Load(const FString& Path, FSaveData& OutSaveData)
+	{
+		return LoadFile(Path, OutSaveData) == true || LoadFile(GetTempPath(Path), OutSaveData) == true;
+	}
+
+	FString GetJournalPath(const FString& SlotName)
+	{
+		return GetSlotPath(SlotName) + TEXT(".journal");
+	}
+
+	void WriteJournalRecord(FArchive& Ar, const FSaveJournalRecord& Record)
+	{
+		uint32 Sequence = Record.Sequence;
+		uint8 Kind = static_cast<uint8>(Record.Category);
+		Kind |= Record.bCompleted == true ? JournalCompletedBit : 0;
+		FString ID = Record.ID.ToString();
+		Ar << Sequence << Kind << ID;
+	}
+
+	// Reads the next record of a journal; false once the journal ends or a record is cut short.
+	bool ReadJournalRecord(FArchive& Ar, FSaveJournalRecord& OutRecord)
+	{
+		if (Ar.AtEnd() == true)
+		{
+			return false;
+		}
+
+		uint8 Kind = 0;
+		FString ID;
+		Ar << OutRecord.Sequence << Kind << ID;
+
+		OutRecord.Category = static_cast<EProgressCategory>(Kind & JournalCategoryMask);
+		OutRecord.bCompleted = (Kind & JournalCompletedBit) != 0;
+		OutRecord.ID = FName(*ID);
+
+		return Ar.IsError() == false && OutRecord.Category < EProgressCategory::MAX && OutRecord.ID.IsNone() == false;
+	}
+
+	bool AppendToFile(const FString& Path, const TArray<uint8>& Bytes)
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append));
+		if (Writer.IsValid() == false)
+		{
+			return false;
+		}
+
+		Writer->Serialize(const_cast<uint8*>(Bytes.GetData()), Bytes.Num());
+		return Writer->Close();
+	}
+
+	uint32 ReplayJournal(const FString& Path, FSaveData& SaveData)
+	{
+		TArray<uint8> Bytes;
+		if (FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent) == false)
+		{
+			return SaveData.JournalSequence;
+		}
+
+		FMemoryReader Reader(Bytes);
+		FSaveJournalRecord Record;
+		while (ReadJournalRecord(Reader, Record) == true)
+		{
+			if (Record.Sequence <= SaveData.JournalSequence)
+			{
+				continue;
+			}
+
+			FProgressFlags& Flags = SaveData.GetFlags(Record.Category);
+			Flags.Set(Flags.Intern(Record.ID), Record.bCompleted);
+			SaveData.JournalSequence = Record.Sequence;
+		}
+
+		return SaveData.JournalSequence;
+	}
+
+	bool CompactJournal(const FString& Path, const uint32 SavedSequence)
+	{
+		TArray<uint8> Bytes;
+		if (FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent) == false)
+		{
+			return true;
+		}
+
+		TArray<uint8> Kept;
+		FMemoryReader Reader(Bytes);
+		FMemoryWriter Writer(Kept);
+		FSaveJournalRecord Record;
+		while (ReadJournalRecord(Reader, Record) == true)
+		{
+			if (Record.Sequence > SavedSequence)
+			{
+				WriteJournalRecord(Writer, Record);
+			}
+		}
+
+		if (Kept.Num() == 0)
+		{
+			return IFileManager::Get().Delete(*Path, false, false, true);
+		}
+		return WriteAtomically(Path, Kept);
+	}
+}
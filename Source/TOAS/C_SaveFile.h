@@ -0,0 +1,100 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "C_StructsAndEnums.h"
+
+// A single completion change of the Save Data, appended to the journal of its slot between full saves.
+struct FSaveJournalRecord
+{
+	// Order of the record; records already included in a full save are skipped when replaying.
+	uint32 Sequence = 0;
+
+	// Kind of progress that changed.
+	EProgressCategory Category = EProgressCategory::CHALLENGE;
+
+	// ID whose completion changed. Records name it rather than its index, since interning an ID isn't journaled
+	// and the saved IDs may not have it yet; replaying interns it first.
+	FName ID;
+
+	// New completion of the ID.
+	bool bCompleted = false;
+};
+
+/**
+ * Reading and writing of save files, kept free of UObjects so every function can run on background threads.
+ * A save file holds a fixed header, a table of sections and the sections themselves, each with its own checksum.
+ * The first section is a small fixed-size block summarizing the slot, so slot lists only read the start of each file.
+ * Sections are stored uncompressed and read straight out of a memory-mapped view of the file.
+ * Next to it, an append-only journal keeps the completion changes made since that save, one small record each.
+ */
+namespace TOASSaveFile
+{
+	// Returns the folder holding the files of every save slot.
+	TOAS_API FString GetSlotDirectory();
+
+	// Returns the path of the file of a save slot.
+	TOAS_API FString GetSlotPath(const FString& SlotName);
+
+	// Returns the names of every save slot in the save folder.
+	TOAS_API TArray<FString> FindSlotNames();
+
+	/**
+	 * Reads the header block of a save slot out of the first bytes of its file, without loading the rest.
+	 * Like the block itself, it doesn't include the changes journaled since the last full save.
+	 */
+	TOAS_API bool ReadSlotHeader(const FString& SlotName, FSaveSlotHeader& OutHeader);
+
+	// Reads the headers of many save slots at once, spread over worker threads; slots that can't be read are left out.
+	TOAS_API TArray<FSaveSlotHeader> ReadSlotHeaders(const TArray<FString>& SlotNames);
+
+	// Lays the Save Data out into the bytes of a save file of the current version.
+	TOAS_API TArray<uint8> Encode(const FSaveData& SaveData);
+
+	/**
+	 * Reads the Save Data out of the bytes of a save file.
+	 * @return False if the bytes are corrupt, fail their checksums or are of another version.
+	 */
+	TOAS_API bool Decode(TConstArrayView<uint8> Bytes, FSaveData& OutSaveData);
+
+	/**
+	 * Writes a save file without ever leaving a partially written one behind: the bytes go to a temporary file
+	 * first, which then replaces the previous save with a rename.
+	 * @return Whether the save file was replaced.
+	 */
+	TOAS_API bool WriteAtomically(const FString& Path, const TArray<uint8>& Bytes);
+
+	/**
+	 * Reads a save file written by WriteAtomically.
+	 * If the game stopped right between removing the old save and renaming the new one, the temporary file is read.
+	 */
+	TOAS_API bool Read(const FString& Path, TArray<uint8>& OutBytes);
+
+	/**
+	 * Loads the Save Data of a save file written by WriteAtomically, decoding it through a memory-mapped view
+	 * so its bytes are never copied. Platforms without mapped files read it into memory instead.
+	 */
+	TOAS_API bool Load(const FString& Path, FSaveData& OutSaveData);
+
+	// Returns the path of the journal of a save slot.
+	TOAS_API FString GetJournalPath(const FString& SlotName);
+
+	// Writes a journal record into an archive, usually a buffer that is appended to the journal later.
+	TOAS_API void WriteJournalRecord(FArchive& Ar, const FSaveJournalRecord& Record);
+
+	// Appends bytes at the end of a file, creating it if needed.
+	TOAS_API bool AppendToFile(const FString& Path, const TArray<uint8>& Bytes);
+
+	/**
+	 * Replays a journal over the Save Data, skipping the records it already includes.
+	 * A record cut short by the game stopping mid-write ends the replay.
+	 * @return Sequence of the last record included in the Save Data afterwards.
+	 */
+	TOAS_API uint32 ReplayJournal(const FString& Path, FSaveData& SaveData);
+
+	// Rewrites a journal keeping only the records newer than a full save; removes it if none are left.
+	TOAS_API bool CompactJournal(const FString& Path, const uint32 SavedSequence);
+}
@@ -12,3 +12,138 @@ C_StructsAndEnums::C_StructsAndEnums()
 C_StructsAndEnums::~C_StructsAndEnums()
 {
 }
+
+int32 FProgressFlags::Intern(const FName ID)
+{
+	if (ID.IsNone() == true)
+	{
+		return INDEX_NONE;
+	}
+
+	RefreshIndex();
+
+	if (const int32* Index = IndexByID.Map.Find(ID))
+	{
+		return *Index;
+	}
+
+	const int32 Index = IDs.Add(ID);
+	IndexByID.Map.Add(ID, Index);
+	CompletionBits.SetNumZeroed((IDs.Num() + 31) >> 5);
+	return Index;
+}
+
+int32 FProgressFlags::Find(const FName ID) const
+{
+	RefreshIndex();
+
+	const int32* Index = IndexByID.Map.Find(ID);
+	return Index != nullptr ? *Index : INDEX_NONE;
+}
+
+void FProgressFlags::Set(const int32 Index, const bool bCompleted)
+{
+	if (IDs.IsValidIndex(Index) == false)
+	{
+		return;
+	}
+
+	// Saves edited by hand may lack words for their last IDs.
+	if (CompletionBits.IsValidIndex(Index >> 5) == false)
+	{
+		CompletionBits.SetNumZeroed((IDs.Num() + 31) >> 5);
+	}
+
+	const uint32 Mask = 1u << (Index & 31);
+	uint32& Word = CompletionBits[Index >> 5];
+	Word = bCompleted == true ? Word | Mask : Word & ~Mask;
+}
+
+void FProgressFlags::RemoveDuplicateIDs()
+{
+	IndexByID.Map.Reset();
+	IndexByID.Map.Reserve(IDs.Num());
+
+	// Every index is read before anything is written to it, since kept IDs only ever move down.
+	int32 Kept = 0;
+	for (int32 Index = 0; Index < IDs.Num(); ++Index)
+	{
+		const FName ID = IDs[Index];
+		const bool bCompleted = IsSet(Index);
+		if (const int32* First = IndexByID.Map.Find(ID))
+		{
+			if (bCompleted == true)
+			{
+				Set(*First, true);
+			}
+			continue;
+		}
+
+		IndexByID.Map.Add(ID, Kept);
+		IDs[Kept] = ID;
+		Set(Kept, bCompleted);
+		++Kept;
+	}
+	IndexByID.bDirty = false;
+
+	if (Kept == IDs.Num())
+	{
+		return;
+	}
+
+	// Bits past the last kept ID would otherwise complete the next IDs interned there.
+	IDs.SetNum(Kept);
+	CompletionBits.SetNumZeroed((Kept + 31) >> 5);
+	if ((Kept & 31) != 0)
+	{
+		CompletionBits.Last() &= (1u << (Kept & 31)) - 1;
+	}
+}
+
+void FProgressFlags::RefreshIndex() const
+{
+	if (IndexByID.bDirty == false)
+	{
+		return;
+	}
+
+	// Repeated IDs resolve to their first index, like RemoveDuplicateIDs keeps them.
+	IndexByID.Map.Reset();
+	IndexByID.Map.Reserve(IDs.Num());
+	for (int32 Index = 0; Index < IDs.Num(); ++Index)
+	{
+		if (IndexByID.Map.Contains(IDs[Index]) == false)
+		{
+			IndexByID.Map.Add(IDs[Index], Index);
+		}
+	}
+	IndexByID.bDirty = false;
+}
+
+FProgressFlags& FSaveData::GetFlags(const EProgressCategory Category)
+{
+	FProgressFlags* Flags = &Challenges;
+	TMap<FString, bool>* LegacyList = &ChallengesList;
+
+	if (Category == EProgressCategory::DIALOGUE)
+	{
+		Flags = &DialogueTriggers;
+		LegacyList = &DialogueTriggersList;
+	}
+	else if (Category == EProgressCategory::CUTSCENE)
+	{
+		Flags = &Cutscenes;
+		LegacyList = &CutsceneList;
+	}
+
+	if (LegacyList->Num() > 0)
+	{
+		for (const TPair<FString, bool>& Entry : *LegacyList)
+		{
+			Flags->Set(Flags->Intern(FName(*Entry.Key)), Entry.Value);
+		}
+		LegacyList->Empty();
+	}
+
+	return *Flags;
+}
@@ -5,6 +5,11 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "CollisionShape.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "Engine/DataTable.h"
+#include "UObject/ObjectKey.h"
 #include "C_StructsAndEnums.generated.h"
 
 class TOAS_API C_StructsAndEnums
@@ -14,19 +19,199 @@ public:
 	~C_StructsAndEnums();
 };
 
+// Used to determine the attribute an attack will have, which will have an effect on damage calculation (using RES).
+UENUM(BlueprintType)
+enum class EElementalAttribute : uint8
+{
+	NEUTRAL UMETA(DisplayName="Neutral Element"),
+	FIRE UMETA(DisplayName = "Fire Element"),
+	ICE UMETA(DisplayName = "Ice Element"),
+	THUNDER UMETA(DisplayName = "Thunder Element"),
+	DARK UMETA(DisplayName = "Dark Element"),
+	NON_LETHAL UMETA(DisplayName = "Non-Lethal Element"),
+	MAX UMETA(Hidden)
+};
+
+// Amount of elements, used to size tables indexed by element.
+constexpr int32 ElementCount = static_cast<int32>(EElementalAttribute::MAX);
+
+// Kinds of progress tracked by the Save Data, each with its own IDs and completion flags.
+UENUM(BlueprintType)
+enum class EProgressCategory : uint8
+{
+	CHALLENGE UMETA(DisplayName="Challenge"),
+	DIALOGUE UMETA(DisplayName="Dialogue Trigger"),
+	CUTSCENE UMETA(DisplayName="Cutscene"),
+	MAX UMETA(Hidden)
+};
+
+// Completion flags of one kind of progress.
+// Every ID is interned once into a dense index, and completion is kept as one bit per index,
+// so queries by index neither hash nor allocate. The IDs are saved in index order, so indices survive loading.
+USTRUCT(BlueprintType)
+struct TOAS_API FProgressFlags
+{
+	GENERATED_BODY()
+
+	// Interned IDs, in index order. Code changing them other than through Intern calls MarkIDsChanged afterwards.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Checklists")
+	TArray<FName> IDs;
+
+	// Completion of every ID, 32 indices per word.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Checklists")
+	TArray<uint32> CompletionBits;
+
+	// Returns the index of an ID, interning it if it's new; INDEX_NONE for empty IDs.
+	int32 Intern(const FName ID);
+
+	// Returns the index of an ID, or INDEX_NONE if it was never interned.
+	int32 Find(const FName ID) const;
+
+	// Checks whether the ID at the given index is completed; false for invalid indices.
+	FORCEINLINE bool IsSet(const int32 Index) const
+	{
+		return CompletionBits.IsValidIndex(Index >> 5) && (CompletionBits[Index >> 5] & (1u << (Index & 31))) != 0;
+	}
+
+	// Sets the completion of the ID at the given index; ignored for invalid indices.
+	void Set(const int32 Index, const bool bCompleted);
+
+	// Makes the next lookup rebuild itself out of the IDs, after they were changed in place.
+	FORCEINLINE void MarkIDsChanged()
+	{
+		IndexByID.bDirty = true;
+	}
+
+	/**
+	 * Removes every repeated ID, keeping its first index and moving its completion there; the indices after
+	 * a removed ID move down. Saves edited by hand may repeat IDs, and Find would only ever see one of them.
+	 */
+	void RemoveDuplicateIDs();
+
+private:
+	// Runtime lookup from ID to index. Copies start dirty, so replacing the flags (like when a save is loaded
+	// and assigned) never keeps a lookup of other IDs; it is rebuilt on the next lookup after being marked dirty.
+	struct FIndexByID
+	{
+		TMap<FName, int32> Map;
+		bool bDirty = true;
+
+		FIndexByID() = default;
+		FIndexByID(const FIndexByID&) {}
+		FIndexByID& operator=(const FIndexByID&) { Map.Reset(); bDirty = true; return *this; }
+	};
+	mutable FIndexByID IndexByID;
+
+	// Rebuilds the lookup from the saved IDs if they were changed since it was last built.
+	void RefreshIndex() const;
+};
+
+// Stats Component block kept by the Save Data.
+USTRUCT(BlueprintType)
+struct FSavedStats
+{
+	GENERATED_BODY()
+
+	// Level of the character; 0 means no stats were saved.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+	uint8 Level = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+	int32 CurrentEXP = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+	uint8 MaxHP = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+	uint8 CurrentHP = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+	uint8 ATK = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+	uint8 DEF = 0;
+
+	// Resistance to each element.
+	UPROPERTY(EditAnywhere, Category = "Stats", meta=(ArraySizeEnum="EElementalAttribute"))
+	uint8 Resistances[ElementCount] = {};
+};
+
 USTRUCT(BlueprintType)
 struct FSaveData
 {
 	GENERATED_BODY()
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Checklists")
-	TMap<FString, bool> ChallengesList;
+	FProgressFlags Challenges;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Checklists")
-	TMap<FString, bool> DialogueTriggersList;
+	FProgressFlags DialogueTriggers;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Checklists")
+	FProgressFlags Cutscenes;
+
+	// Lists kept by older saves; moved into the flags above the first time they are used, and left empty.
+	// Still visible to Blueprints until every asset reading them is moved to the flags.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Checklists", meta = (DeprecatedProperty,
+		DeprecationMessage = "Use UpdateChallengeOnSaveData and GetChallengeCompletionOnSaveData on the Game Manager."))
+	TMap<FString, bool> ChallengesList;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Checklists", meta = (DeprecatedProperty,
+		DeprecationMessage = "Use UpdateDialogueOnSaveData and GetDialogueCompletionOnSaveData on the Game Manager."))
+	TMap<FString, bool> DialogueTriggersList;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Checklists", meta = (DeprecatedProperty,
+		DeprecationMessage = "Use UpdateCutsceneOnSaveData and GetCutsceneCompletionOnSaveData on the Game Manager."))
 	TMap<FString, bool> CutsceneList;
+
+	// Stats of the player character when the game was saved.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+	FSavedStats PlayerStats;
+
+	// Seconds played on this Save Data.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Slot")
+	double PlayTime = 0.0;
+
+	// Zone the player was in when the game was saved.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Slot")
+	FName LastZone;
+
+	// Last journal record included in this Save Data; newer records are replayed over it when loading.
+	UPROPERTY()
+	uint32 JournalSequence = 0;
+
+	// Returns the flags of a kind of progress, moving any list from older saves into them first.
+	FProgressFlags& GetFlags(const EProgressCategory Category);
+};
+
+// Summary of a save slot, read from the small header block of its file without loading the rest.
+USTRUCT(BlueprintType)
+struct FSaveSlotHeader
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Slot")
+	FString SlotName;
+
+	// Level of the player character; 0 if no stats were saved.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Slot")
+	uint8 Level = 0;
+
+	// Seconds played on the slot.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Slot")
+	double PlayTime = 0.0;
+
+	// Amount of Challenges completed.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Slot")
+	int32 ChallengesCompleted = 0;
+
+	// Zone the player was in when the slot was saved.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Slot")
+	FName LastZone;
+
+	// Time the slot was saved, in UTC.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Slot")
+	FDateTime SavedAt;
 };
 
 // Properties for Attack Traces called during Animations.
@@ -68,6 +253,24 @@ struct FAttackProperties
 	// How far will the enemy be raised when Hit (from Trace).
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Properties", meta=(AllowPrivateAccess=true))
 	float AttackUpImpulse = 100.0f;
+
+	// Element of the attack, reduced by the matching resistance of whoever gets Hit (from Trace).
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Properties", meta=(AllowPrivateAccess=true))
+	EElementalAttribute Element = EElementalAttribute::NEUTRAL;
+};
+
+// Registry of the actors already hit during a single swing, so each victim is resolved at most once per swing.
+// Shared between the notify running the swing and the sweeps still waiting for their results.
+struct FAttackHitRegistry
+{
+	// Actors already hit during this swing.
+	TSet<TObjectKey<AActor>> HitActors;
+
+	// Checks if the Actor was already hit during this swing.
+	FORCEINLINE bool WasHit(const AActor* Actor) const { return HitActors.Contains(TObjectKey<AActor>(Actor)); }
+
+	// Registers the Actor as hit during this swing.
+	FORCEINLINE void RegisterHit(const AActor* Actor) { HitActors.Add(TObjectKey<AActor>(Actor)); }
 };
 
 // Used for AnimNoifies and AnimNotifyStates to check from which hand Sol will attack, using specific sockets/bones.
@@ -78,16 +281,50 @@ enum class ESolHandAttack : uint8
 	RIGHT UMETA(DisplayName = "Right Hand")
 };
 
-// Used to determine the attribute an attack will have, which will have an effect on damage calculation (using RES).
+// Immutable, ready-to-trace version of FAttackProperties. Compiled once (when an attack notify begins),
+// so tracing an attack every tick neither copies the object type array nor converts it into query params.
+// Socket names are resolved per mesh, through each Attacker's Socket Cache.
+struct FAttackDescriptor
+{
+	// Object types to hit, already converted into query params.
+	FCollisionObjectQueryParams ObjectQueryParams;
+
+	// Sphere used to sweep the attack.
+	FCollisionShape CollisionShape;
+
+	// Multiplier that affects the damage on Hit.
+	float AttackMultiplier = 1.0f;
+
+	// How far will the enemy be pushed when Hit.
+	float AttackForwardImpulse = -500.0f;
+
+	// How far will the enemy be raised when Hit.
+	float AttackUpImpulse = 100.0f;
+
+	// Element of the attack, used by the damage calculation.
+	EElementalAttribute Element = EElementalAttribute::NEUTRAL;
+
+	// Builds the descriptor out of the editable Attack Properties.
+	static FAttackDescriptor Compile(const FAttackProperties& AttackProperties)
+	{
+		FAttackDescriptor Descriptor;
+		Descriptor.ObjectQueryParams = FCollisionObjectQueryParams(AttackProperties.HitObjectTypes);
+		Descriptor.CollisionShape = FCollisionShape::MakeSphere(AttackProperties.RadiusOfAttack);
+		Descriptor.AttackMultiplier = AttackProperties.AttackMultiplier;
+		Descriptor.AttackForwardImpulse = AttackProperties.AttackForwardImpulse;
+		Descriptor.AttackUpImpulse = AttackProperties.AttackUpImpulse;
+		Descriptor.Element = AttackProperties.Element;
+		return Descriptor;
+	}
+};
+
+// How the Z-Targeting System is currently marking a character, drawn by the Lock-On Presenter.
 UENUM(BlueprintType)
-enum class EElementalAttribute : uint8
+enum class ETargetMark : uint8
 {
-	NEUTRAL UMETA(DisplayName="Neutral Element"),
-	FIRE UMETA(DisplayName = "Fire Element"),
-	ICE UMETA(DisplayName = "Ice Element"),
-	THUNDER UMETA(DisplayName = "Thunder Element"),
-	DARK UMETA(DisplayName = "Dark Element"),
-	NON_LETHAL UMETA(DisplayName = "Non-Lethal Element"),
+	NONE UMETA(DisplayName="None"),
+	SEEN UMETA(DisplayName="Seen"),
+	TARGETED UMETA(DisplayName="Targeted")
 };
 
 // Enumerator to choose what prompts to use for controls.
@@ -98,4 +335,90 @@ enum class EPromptControl : uint8
 	XBOX = 1 UMETA(DisplayName="Xbox"),
 	PS = 2 UMETA(DisplayName="PS"),
 	SWITCH = 3 UMETA(DisplayName="Switch")
-};
\ No newline at end of file
+};
+
+// Update settings applied to an enemy while it stays within a significance tier.
+// Tiers are sorted from most to least significant; the first one whose distance isn't surpassed is used.
+USTRUCT(BlueprintType)
+struct FSignificanceTier
+{
+	GENERATED_BODY()
+
+	// Distance to the player (in cm) up to which this tier is used.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Significance", meta=(AllowPrivateAccess=true))
+	float MaxDistance = 1500.0f;
+
+	// Seconds between ticks of the Actor; 0 ticks every frame.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Significance", meta=(AllowPrivateAccess=true))
+	float ActorTickInterval = 0.0f;
+
+	// Seconds between updates of the Character Movement Component; 0 updates every frame.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Significance", meta=(AllowPrivateAccess=true))
+	float MovementTickInterval = 0.0f;
+
+	// If true, the Skeletal Mesh skips animation updates based on its size on screen (Update Rate Optimizations).
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Significance", meta=(AllowPrivateAccess=true))
+	bool bUseUpdateRateOptimizations = false;
+
+	// How the Skeletal Mesh animates while not rendered.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Significance", meta=(AllowPrivateAccess=true))
+	EVisibilityBasedAnimTickOption AnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+};
+
+// Stats of a character class at a given level, as a row of a growth Data Table.
+// Levels between rows are interpolated when the table is baked, so only the key levels need a row.
+USTRUCT(BlueprintType)
+struct FStatGrowthRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	// Level described by this row.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Growth", meta=(AllowPrivateAccess=true, ClampMin=1))
+	uint8 Level = 1;
+
+	// Total Experience needed to reach this level.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Growth", meta=(AllowPrivateAccess=true, ClampMin=0))
+	int32 TotalEXP = 0;
+
+	// Max amount of Hit Points at this level.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Growth", meta=(AllowPrivateAccess=true))
+	uint8 MaxHP = 10;
+
+	// Attack power at this level.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Growth", meta=(AllowPrivateAccess=true))
+	uint8 ATK = 5;
+
+	// Defense at this level.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Growth", meta=(AllowPrivateAccess=true))
+	uint8 DEF = 2;
+
+	// Resistances to fire, ice, electric and darkness based attacks at this level.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Growth", meta=(AllowPrivateAccess=true))
+	uint8 FireRES = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Growth", meta=(AllowPrivateAccess=true))
+	uint8 IceRES = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Growth", meta=(AllowPrivateAccess=true))
+	uint8 ThunderRES = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Growth", meta=(AllowPrivateAccess=true))
+	uint8 DarkRES = 0;
+};
+
+// Zone of the world streamed in as a sublevel of the persistent level, as a row of a zone graph Data Table.
+// The row name is the name of the zone.
+USTRUCT(BlueprintType)
+struct FZoneRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	// Sublevel holding the zone.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Zone")
+	TSoftObjectPtr<UWorld> Level;
+
+	// Space covered by the zone; the player is in the zone while inside of it.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Zone")
+	FBox Bounds = FBox(ForceInit);
+
+	// Zones reachable straight from this one, by row name.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Zone")
+	TArray<FName> Neighbours;
+};
@@ -0,0 +1,96 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_WB_LockOnPresenter.h"
+#include "C_PlayableCharacter.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/CanvasPanel.h"
+#include "Components/CanvasPanelSlot.h"
+
+void UC_WB_LockOnPresenter::SetTrackingCharacter(AC_PlayableCharacter* Character)
+{
+	TrackingCharacter = Character;
+}
+
+void UC_WB_LockOnPresenter::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	if (SeenMarker == nullptr)
+	{
+		SeenMarker = CreateMarker(SeenMarkerClass, FName("SeenMarker"));
+	}
+	if (LockOnMarker == nullptr)
+	{
+		LockOnMarker = CreateMarker(LockOnMarkerClass, FName("LockOnMarker"));
+	}
+}
+
+UUserWidget* UC_WB_LockOnPresenter::CreateMarker(const TSoftClassPtr<UUserWidget>& MarkerClass, const FName Name)
+{
+	UClass* LoadedClass = MarkerClass.LoadSynchronous();
+	if (LoadedClass == nullptr || WidgetTree == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Without a designer there is no root yet, so a Canvas Panel covering the screen is made the root.
+	UCanvasPanel* Canvas = Cast<UCanvasPanel>(WidgetTree->RootWidget);
+	if (Canvas == nullptr)
+	{
+		if (WidgetTree->RootWidget != nullptr)
+		{
+			return nullptr;
+		}
+		Canvas = WidgetTree->ConstructWidget<UCanvasPanel>(UCanvasPanel::StaticClass(), FName("MarkerCanvas"));
+		WidgetTree->RootWidget = Canvas;
+	}
+
+	UUserWidget* Marker = CreateWidget<UUserWidget>(this, LoadedClass, Name);
+	if (UCanvasPanelSlot* MarkerSlot = Canvas->AddChildToCanvas(Marker))
+	{
+		MarkerSlot->SetAnchors(FAnchors(0.0f, 0.0f));
+		MarkerSlot->SetAlignment(FVector2D(0.5f, 0.5f));
+		MarkerSlot->SetAutoSize(true);
+	}
+	Marker->SetVisibility(ESlateVisibility::Collapsed);
+	return Marker;
+}
+
+void UC_WB_LockOnPresenter::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	const AC_PlayableCharacter* Character = TrackingCharacter.Get();
+
+	PresentMarker(SeenMarker, Character != nullptr ? Character->GetSeenTarget() : nullptr, ETargetMark::SEEN);
+	PresentMarker(LockOnMarker, Character != nullptr ? Character->GetZTargetToTrack() : nullptr,
+		ETargetMark::TARGETED);
+}
+
+void UC_WB_LockOnPresenter::PresentMarker(UUserWidget* Marker, const ATOASCharacter* Character,
+	const ETargetMark ExpectedMark) const
+{
+	if (Marker == nullptr)
+	{
+		return;
+	}
+
+	FVector2D ScreenPosition;
+	const bool bOnScreen = IsValid(Character) == true && Character->GetTargetMark() == ExpectedMark
+		&& UWidgetLayoutLibrary::ProjectWorldLocationToWidgetPosition(GetOwningPlayer(),
+			Character->GetActorLocation() + MarkerWorldOffset, ScreenPosition, true);
+
+	if (bOnScreen == false)
+	{
+		Marker->SetVisibility(ESlateVisibility::Collapsed);
+		return;
+	}
+
+	// Render Translation moves the marker without invalidating the layout of the canvas.
+	Marker->SetRenderTranslation(ScreenPosition);
+	Marker->SetVisibility(ESlateVisibility::HitTestInvisible);
+}
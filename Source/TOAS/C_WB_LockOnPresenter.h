@@ -0,0 +1,74 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "C_WB_LockOnPresenter.generated.h"
+
+class AC_PlayableCharacter;
+class ATOASCharacter;
+enum class ETargetMark : uint8;
+
+/**
+ * Screen-space presenter for the Z-Targeting System, added once to the player's screen.
+ * Draws the Seen and Lock-On indicators over the player's Seen Target and Target being Tracked,
+ * projecting both locations once per frame instead of every character owning its own world-space widgets.
+ * Markers placed in a designer subclass must be in a Canvas Panel, anchored to the top left corner with a centered
+ * alignment; without them (like when this class is used as is), they are created from the marker classes.
+ */
+UCLASS()
+class TOAS_API UC_WB_LockOnPresenter : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	// Sets the character whose Seen Target and Target being Tracked are presented.
+	UFUNCTION(BlueprintCallable, Category=UI)
+	void SetTrackingCharacter(AC_PlayableCharacter* Character);
+
+protected:
+	// Creates the markers missing from the designer, along with the Canvas Panel holding them.
+	virtual void NativeOnInitialized() override;
+
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+	// Marker drawn over the Seen Target (WB_Seen).
+	UPROPERTY(BlueprintReadOnly, meta = (AllowPrivateAccess=true, BindWidgetOptional))
+	UUserWidget* SeenMarker;
+
+	// Marker drawn over the Target being Tracked (WB_LockOn).
+	UPROPERTY(BlueprintReadOnly, meta = (AllowPrivateAccess=true, BindWidgetOptional))
+	UUserWidget* LockOnMarker;
+
+	// Widget created as the Seen marker when the designer doesn't place one.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=UI, meta = (AllowPrivateAccess=true))
+	TSoftClassPtr<UUserWidget> SeenMarkerClass{ FSoftObjectPath(TEXT("/Game/Widgets/LockOnSystem/WB_Seen.WB_Seen_C")) };
+
+	// Widget created as the Lock-On marker when the designer doesn't place one.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=UI, meta = (AllowPrivateAccess=true))
+	TSoftClassPtr<UUserWidget> LockOnMarkerClass{
+		FSoftObjectPath(TEXT("/Game/Widgets/LockOnSystem/WB_LockOn.WB_LockOn_C")) };
+
+	// Offset from the character's location where the markers are drawn.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=UI, meta = (AllowPrivateAccess=true))
+	FVector MarkerWorldOffset = FVector::ZeroVector;
+
+private:
+	/**
+	 * Shows the marker over the character if it's marked as expected, hiding it otherwise.
+	 * @param Marker Marker to place.
+	 * @param Character Character to draw the marker over; may be null.
+	 * @param ExpectedMark Mark the character must have for the marker to be shown.
+	 */
+	void PresentMarker(UUserWidget* Marker, const ATOASCharacter* Character, const ETargetMark ExpectedMark) const;
+
+	// Creates a marker of the given class in the Canvas Panel, anchored as the markers expect.
+	UUserWidget* CreateMarker(const TSoftClassPtr<UUserWidget>& MarkerClass, const FName Name);
+
+	// Character whose targets are presented.
+	UPROPERTY()
+	TWeakObjectPtr<AC_PlayableCharacter> TrackingCharacter;
+};
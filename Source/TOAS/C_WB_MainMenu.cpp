@@ -106,4 +106,33 @@ void UC_WB_MainMenu::NativeOnInitialized()
 	Super::NativeOnInitialized();
 	ConnectPlayerToGame();
 	UpdateControlPrompts();
+	RefreshSaveSlots();
+
+	if (NewGameButton != nullptr && NewGameButton->GetCustomButton() != nullptr)
+	{
+		NewGameButton->GetCustomButton()->OnClicked.AddUniqueDynamic(this, &UC_WB_MainMenu::OnNewGameClicked);
+	}
+}
+
+void UC_WB_MainMenu::RefreshSaveSlots()
+{
+	if (UC_GI_GameManager* GI_GameManager = Cast<UC_GI_GameManager>(GetWorld()->GetGameInstance()))
+	{
+		GI_GameManager->OnSaveSlotsEnumerated.AddUniqueDynamic(this, &UC_WB_MainMenu::OnSaveSlotsEnumerated);
+		GI_GameManager->EnumerateSaveSlots();
+	}
+}
+
+void UC_WB_MainMenu::OnSaveSlotsEnumerated(const TArray<FSaveSlotHeader>& Slots)
+{
+	SaveSlots = Slots;
+	PopulateSlotList(SaveSlots);
+}
+
+void UC_WB_MainMenu::OnNewGameClicked()
+{
+	if (UC_GI_GameManager* GI_GameManager = Cast<UC_GI_GameManager>(GetWorld()->GetGameInstance()))
+	{
+		GI_GameManager->StartNewGame();
+	}
 }
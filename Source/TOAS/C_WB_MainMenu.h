@@ -6,6 +6,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "C_StructsAndEnums.h"
 #include "C_WB_MainMenu.generated.h"
 
 class UC_UW_SelectButton;
@@ -49,6 +50,14 @@ public:
 	UFUNCTION()
 	virtual void NativeOnInitialized() override;
 
+	// Asks the Game Instance for the save slots; the list is populated once their headers are read.
+	UFUNCTION(BlueprintCallable, Category=UI)
+	void RefreshSaveSlots();
+
+	// Builds the entries of the slot list, most recently saved first.
+	UFUNCTION(BlueprintImplementableEvent, Category=UI)
+	void PopulateSlotList(const TArray<FSaveSlotHeader>& Slots);
+
 protected:
 	UPROPERTY(BlueprintReadOnly, meta = (AllowPrivateAccess=true, BindWidget))
 	UC_UW_SelectButton* NewGameButton;
@@ -73,4 +82,15 @@ protected:
 
 	UPROPERTY(BlueprintReadOnly, meta = (AllowPrivateAccess=true, BindWidget))
 	UC_UW_SelectButton* ReturnFromCreditsButton;
+
+	// Save slots last listed by the Game Instance.
+	UPROPERTY(BlueprintReadOnly, meta = (AllowPrivateAccess=true))
+	TArray<FSaveSlotHeader> SaveSlots;
+
+	UFUNCTION()
+	void OnSaveSlotsEnumerated(const TArray<FSaveSlotHeader>& Slots);
+
+	// Starts a fresh Save Data on the Game Instance, so the new game's play time begins now.
+	UFUNCTION()
+	void OnNewGameClicked();
 };
\ No newline at end of file
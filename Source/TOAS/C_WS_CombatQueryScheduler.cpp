@@ -0,0 +1,110 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_WS_CombatQueryScheduler.h"
+#include "TOASCharacter.h"
+#include "TOAS.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Query Scheduler"), STAT_TOAS_CombatQueryScheduler, STATGROUP_TOAS);
+
+void UC_WS_CombatQueryScheduler::QueueSweep(ATOASCharacter* Attacker, const FVector& StartLocation,
+	const FVector& EndLocation, const TSharedPtr<const FAttackDescriptor>& Attack, const bool bMultiHit,
+	const TSharedPtr<FAttackHitRegistry>& HitRegistry)
+{
+	if (IsValid(Attacker) == false || Attack.IsValid() == false)
+	{
+		return;
+	}
+
+	FCombatSweepRequest& Request = QueuedSweeps.AddDefaulted_GetRef();
+	Request.Attacker = Attacker;
+	Request.Attack = Attack;
+	Request.StartLocation = StartLocation;
+	Request.EndLocation = EndLocation;
+	Request.bMultiHit = bMultiHit;
+	Request.HitRegistry = HitRegistry;
+}
+
+void UC_WS_CombatQueryScheduler::Tick(float DeltaTime)
+{
+	TOAS_SCOPE(CombatQueryScheduler);
+
+	Super::Tick(DeltaTime);
+
+	// Results are always resolved before issuing new sweeps, so damage from last frame's swings
+	// lands at the same point of every frame.
+	ResolveInFlightSweeps();
+	IssueQueuedSweeps();
+}
+
+TStatId UC_WS_CombatQueryScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UC_WS_CombatQueryScheduler, STATGROUP_Tickables);
+}
+
+void UC_WS_CombatQueryScheduler::Deinitialize()
+{
+	QueuedSweeps.Empty();
+	InFlightSweeps.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UC_WS_CombatQueryScheduler::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UC_WS_CombatQueryScheduler::ResolveInFlightSweeps()
+{
+	UWorld* World = GetWorld();
+
+	for (FCombatSweepRequest& Request : InFlightSweeps)
+	{
+		ATOASCharacter* Attacker = Request.Attacker.Get();
+
+		// The attacker may have been destroyed while its sweep was in flight.
+		if (IsValid(Attacker) == false)
+		{
+			continue;
+		}
+
+		// Handles expire after one frame, so anything not found here is simply dropped.
+		FTraceDatum TraceData;
+		if (World->QueryTraceData(Request.TraceHandle, TraceData) == false)
+		{
+			continue;
+		}
+
+		Attacker->ResolveAttackHits(TraceData.OutHits, *Request.Attack, Request.bMultiHit,
+			Request.HitRegistry.Get());
+	}
+
+	// Keep the allocation; it will be reused as the queue for the next frame.
+	// Resetting also releases the references to the registries of swings that already ended.
+	InFlightSweeps.Reset();
+}
+
+void UC_WS_CombatQueryScheduler::IssueQueuedSweeps()
+{
+	UWorld* World = GetWorld();
+
+	for (FCombatSweepRequest& Request : QueuedSweeps)
+	{
+		// Same settings the Kismet trace used: simple collision and ignoring the attacker itself.
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TOASAttackSweep), false, Request.Attacker.Get());
+
+		Request.TraceHandle = World->AsyncSweepByObjectType(
+			Request.bMultiHit ? EAsyncTraceType::Multi : EAsyncTraceType::Single,
+			Request.StartLocation, Request.EndLocation, FQuat::Identity,
+			Request.Attack->ObjectQueryParams, Request.Attack->CollisionShape, QueryParams);
+	}
+
+	TOASCounters::AttackTraces += QueuedSweeps.Num();
+
+	// The issued sweeps become next frame's in-flight sweeps, and the emptied buffer becomes the new queue.
+	Swap(QueuedSweeps, InFlightSweeps);
+}
@@ -0,0 +1,87 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "C_StructsAndEnums.h"
+#include "WorldCollision.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "C_WS_CombatQueryScheduler.generated.h"
+
+class ATOASCharacter;
+
+// A single weapon sweep registered by an attack notify during the frame.
+struct FCombatSweepRequest
+{
+	// Character that requested the sweep and that will resolve its hits.
+	TWeakObjectPtr<ATOASCharacter> Attacker;
+
+	// Compiled attack, shared with the notify that requested the sweep.
+	TSharedPtr<const FAttackDescriptor> Attack;
+
+	// World Location where the sweep begins.
+	FVector StartLocation = FVector::ZeroVector;
+
+	// World Location where the sweep ends.
+	FVector EndLocation = FVector::ZeroVector;
+
+	// Whether the sweep must return every hit or only the first blocking one.
+	bool bMultiHit = false;
+
+	// Registry of the swing that requested the sweep; kept alive even if the swing ends before the results arrive.
+	TSharedPtr<FAttackHitRegistry> HitRegistry;
+
+	// Handle to the async physics query once it has been issued.
+	FTraceHandle TraceHandle;
+};
+
+/**
+ * World Subsystem that collects every weapon sweep requested during a frame and issues them together as
+ * asynchronous physics queries. Results are resolved at a fixed point on the following frame (this subsystem's Tick),
+ * letting combat queries overlap with animation and rendering instead of blocking the game thread per attacker.
+ */
+UCLASS()
+class TOAS_API UC_WS_CombatQueryScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Registers a sphere sweep to be issued at the end of this frame and resolved on the next one.
+	 * @param Attacker Character performing the attack; it will receive the hits once resolved.
+	 * @param StartLocation World Location where the sweep begins.
+	 * @param EndLocation World Location where the sweep ends.
+	 * @param Attack Compiled attack (shape, object types, multiplier, impulses and element).
+	 * @param bMultiHit If true, every hit along the sweep is resolved instead of only the first one.
+	 * @param HitRegistry Optional registry of the swing, so each victim is only resolved once per swing.
+	 */
+	void QueueSweep(ATOASCharacter* Attacker, const FVector& StartLocation, const FVector& EndLocation,
+		const TSharedPtr<const FAttackDescriptor>& Attack, const bool bMultiHit = false,
+		const TSharedPtr<FAttackHitRegistry>& HitRegistry = nullptr);
+
+	// Resolves last frame's sweeps and then issues the ones queued during this frame.
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+protected:
+	// Combat only happens in game worlds, so editor and preview worlds do not get a scheduler.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Reads the results of the sweeps issued last frame and sends them to their attackers.
+	void ResolveInFlightSweeps();
+
+	// Issues every sweep queued during this frame as async physics queries.
+	void IssueQueuedSweeps();
+
+	// Sweeps requested during the current frame, waiting to be issued.
+	TArray<FCombatSweepRequest> QueuedSweeps;
+
+	// Sweeps issued last frame, waiting for their results.
+	TArray<FCombatSweepRequest> InFlightSweeps;
+};
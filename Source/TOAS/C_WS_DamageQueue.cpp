@@ -0,0 +1,105 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_WS_DamageQueue.h"
+#include "TOAS.h"
+#include "C_AComp_Stats.h"
+#include "TOASCharacter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Queue"), STAT_TOAS_DamageQueue, STATGROUP_TOAS);
+
+void UC_WS_DamageQueue::QueueDamage(const FDamageRecord& Damage)
+{
+	QueuedDamage.Add(Damage);
+}
+
+int32 UC_WS_DamageQueue::FindStrongestHit(TConstArrayView<FDamageRecord> Hits, const UC_AComp_Stats* Stats)
+{
+	if (Hits.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+	if (Stats == nullptr)
+	{
+		return 0;
+	}
+
+	int32 Strongest = 0;
+	int32 StrongestDamage = Stats->CalculatePhysicalDamage(Hits[0].InstigatorATK, Hits[0].Multiplier, Hits[0].Element);
+	for (int32 Index = 1; Index < Hits.Num(); ++Index)
+	{
+		const int32 Damage =
+			Stats->CalculatePhysicalDamage(Hits[Index].InstigatorATK, Hits[Index].Multiplier, Hits[Index].Element);
+		if (Damage > StrongestDamage)
+		{
+			Strongest = Index;
+			StrongestDamage = Damage;
+		}
+	}
+	return Strongest;
+}
+
+void UC_WS_DamageQueue::Tick(float DeltaTime)
+{
+	TOAS_SCOPE(DamageQueue);
+
+	Super::Tick(DeltaTime);
+
+	if (QueuedDamage.Num() == 0)
+	{
+		return;
+	}
+
+	Swap(QueuedDamage, ResolvingDamage);
+
+	// Stable, so hits of the same strength on a victim keep the order they landed in.
+	ResolvingDamage.StableSort([](const FDamageRecord& A, const FDamageRecord& B)
+	{
+		return A.VictimId < B.VictimId;
+	});
+
+	int32 First = 0;
+	while (First < ResolvingDamage.Num())
+	{
+		int32 Last = First + 1;
+		while (Last < ResolvingDamage.Num() && ResolvingDamage[Last].VictimId == ResolvingDamage[First].VictimId)
+		{
+			++Last;
+		}
+
+		// The victim may have been destroyed since it was hit.
+		ATOASCharacter* Victim = ResolvingDamage[First].Victim.Get();
+		if (Victim != nullptr)
+		{
+			// Every hit on the same victim is merged into the strongest one; the rest would be blocked
+			// by the invulnerability the first one grants anyway.
+			const TConstArrayView<FDamageRecord> Hits = MakeArrayView(&ResolvingDamage[First], Last - First);
+			Victim->ResolveDamage(Hits[FindStrongestHit(Hits, Victim->GetStats())], Hits);
+		}
+
+		First = Last;
+	}
+
+	// Keep the allocation; it will be reused as the queue for the next frame.
+	ResolvingDamage.Reset();
+}
+
+TStatId UC_WS_DamageQueue::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UC_WS_DamageQueue, STATGROUP_Tickables);
+}
+
+void UC_WS_DamageQueue::Deinitialize()
+{
+	QueuedDamage.Empty();
+	ResolvingDamage.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UC_WS_DamageQueue::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
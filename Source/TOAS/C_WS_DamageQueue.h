@@ -0,0 +1,86 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "C_StructsAndEnums.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "C_WS_DamageQueue.generated.h"
+
+class ATOASCharacter;
+class UC_AComp_Stats;
+
+// A single hit waiting to be applied to its victim.
+struct FDamageRecord
+{
+	// Character receiving the damage.
+	TWeakObjectPtr<ATOASCharacter> Victim;
+
+	// Character that dealt the damage; empty for hazards and other sources without a character.
+	TWeakObjectPtr<ATOASCharacter> Instigator;
+
+	// World Location the damage came from; the victim turns to face it.
+	FVector InstigatorLocation = FVector::ZeroVector;
+
+	// Multiplier of the hit, obtained from the attack.
+	float Multiplier = 1.0f;
+
+	// How far will the victim be pushed.
+	float FwdImpulse = 0.0f;
+
+	// How far will the victim be raised.
+	float UpImpulse = 0.0f;
+
+	// Unique ID of the victim, used to sort the queue by victim without resolving the weak pointers.
+	uint32 VictimId = 0;
+
+	// Attack stat of the instigator.
+	uint8 InstigatorATK = 0;
+
+	// Element of the hit.
+	EElementalAttribute Element = EElementalAttribute::NEUTRAL;
+};
+
+/**
+ * World Subsystem that gathers every hit landed during a frame and applies them in a single pass.
+ * Hits are sorted by victim, simultaneous hits on the same victim are merged into the strongest one, and knockback,
+ * damage and the reaction events happen once per victim, away from the physics queries that found the hits.
+ */
+UCLASS()
+class TOAS_API UC_WS_DamageQueue : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Registers a hit to be applied during this subsystem's next Tick.
+	void QueueDamage(const FDamageRecord& Damage);
+
+	/**
+	 * Picks the hit that the simultaneous hits on a victim are merged into: the one dealing the most damage
+	 * after the victim's defense and resistances. Ties keep the hit that landed first.
+	 * @param Hits Hits landed on the same victim during a frame, in the order they landed.
+	 * @param Stats Stats of the victim; without them, the first hit is picked.
+	 * @return Index of the strongest hit within Hits; INDEX_NONE if there are none.
+	 */
+	static int32 FindStrongestHit(TConstArrayView<FDamageRecord> Hits, const UC_AComp_Stats* Stats);
+
+	// Applies every hit queued since the last Tick.
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+protected:
+	// Combat only happens in game worlds, so editor and preview worlds apply damage right away.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Hits queued since the last Tick.
+	TArray<FDamageRecord> QueuedDamage;
+
+	// Hits being applied; separate from the queue so reactions that deal damage wait for the next pass.
+	TArray<FDamageRecord> ResolvingDamage;
+};
@@ -0,0 +1,160 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_WS_EnemyCrowd.h"
+#include "TOAS.h"
+#include "C_AComp_Stats.h"
+#include "C_EnemyCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Crowd"), STAT_TOAS_EnemyCrowd, STATGROUP_TOAS);
+
+void UC_WS_EnemyCrowd::AddCrowdMember(TSubclassOf<AC_EnemyCharacter> EnemyClass, const FTransform& Transform)
+{
+	if (EnemyClass == nullptr)
+	{
+		return;
+	}
+
+	const AC_EnemyCharacter* Defaults = EnemyClass->GetDefaultObject<AC_EnemyCharacter>();
+
+	EnemyClasses.Add(EnemyClass);
+	Locations.Add(Transform.GetLocation());
+	Yaws.Add(Transform.Rotator().Yaw);
+	Levels.Add(Defaults->GetStats()->GetLevel());
+	CurrentHPs.Add(Defaults->GetStats()->GetMaxHP());
+	SightDistances.Add(Defaults->GetSightDistance());
+	SightRadii.Add(Defaults->GetSightRadius());
+}
+
+void UC_WS_EnemyCrowd::Tick(float DeltaTime)
+{
+	TOAS_SCOPE(EnemyCrowd);
+
+	Super::Tick(DeltaTime);
+
+	const ACharacter* Player = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+	if (Player == nullptr)
+	{
+		return;
+	}
+
+	const FVector PlayerLocation = Player->GetActorLocation();
+
+	// Promoted enemies that got far from the player, without having found them, go back into the crowd.
+	// Defeated ones leave it for good, so they are neither stored with no Hit Points nor spawned again.
+	for (int32 Index = PromotedEnemies.Num() - 1; Index >= 0; --Index)
+	{
+		AC_EnemyCharacter* Enemy = PromotedEnemies[Index].Get();
+		if (Enemy == nullptr || Enemy->GetStats()->GetCurrentHP() <= 0)
+		{
+			PromotedEnemies.RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (Enemy->HasFoundPlayer() == false
+			&& FVector::DistSquared(Enemy->GetActorLocation(), PlayerLocation) > FMath::Square(DemotionDistance))
+		{
+			PromotedEnemies.RemoveAtSwap(Index);
+			DemoteEnemy(Enemy);
+		}
+	}
+
+	const int32 NumMembers = EnemyClasses.Num();
+	if (NumMembers == 0)
+	{
+		return;
+	}
+
+	// Members are promoted when close to the player, or when the player stands inside their sight sphere,
+	// within the budget for this frame. The test is a few multiplications per member, cheaper than handing it
+	// to worker threads. Going backwards, promoting only moves members already tested into the freed index.
+	const float PromotionDistanceSquared = FMath::Square(PromotionDistance);
+	int32 PromotionsLeft = PromotionBudget;
+	for (int32 Index = NumMembers - 1; Index >= 0 && PromotionsLeft > 0; --Index)
+	{
+		const FVector& Location = Locations[Index];
+		const FVector SightCenter = Location
+			+ FRotator(0.0f, Yaws[Index], 0.0f).Vector() * SightDistances[Index];
+
+		if (FVector::DistSquared(Location, PlayerLocation) <= PromotionDistanceSquared
+			|| FVector::DistSquared(SightCenter, PlayerLocation) <= FMath::Square(SightRadii[Index]))
+		{
+			PromoteMember(Index);
+			--PromotionsLeft;
+		}
+	}
+}
+
+void UC_WS_EnemyCrowd::PromoteMember(const int32 Index)
+{
+	const FTransform SpawnTransform(FRotator(0.0f, Yaws[Index], 0.0f), Locations[Index]);
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AC_EnemyCharacter* Enemy = GetWorld()->SpawnActor<AC_EnemyCharacter>(EnemyClasses[Index], SpawnTransform,
+		SpawnParameters);
+	if (Enemy != nullptr)
+	{
+		// Stats are restored after BeginPlay, which resets the Hit Points of new characters.
+		Enemy->GetStats()->RestoreStats(Levels[Index], CurrentHPs[Index]);
+		PromotedEnemies.Add(Enemy);
+	}
+
+	RemoveAtSwap(Index);
+}
+
+void UC_WS_EnemyCrowd::DemoteEnemy(AC_EnemyCharacter* Enemy)
+{
+	const UC_AComp_Stats* Stats = Enemy->GetStats();
+
+	EnemyClasses.Add(Enemy->GetClass());
+	Locations.Add(Enemy->GetActorLocation());
+	Yaws.Add(Enemy->GetActorRotation().Yaw);
+	Levels.Add(Stats->GetLevel());
+	CurrentHPs.Add(Stats->GetCurrentHP());
+	SightDistances.Add(Enemy->GetSightDistance());
+	SightRadii.Add(Enemy->GetSightRadius());
+
+	Enemy->Destroy();
+}
+
+TStatId UC_WS_EnemyCrowd::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UC_WS_EnemyCrowd, STATGROUP_Tickables);
+}
+
+void UC_WS_EnemyCrowd::Deinitialize()
+{
+	EnemyClasses.Empty();
+	Locations.Empty();
+	Yaws.Empty();
+	Levels.Empty();
+	CurrentHPs.Empty();
+	SightDistances.Empty();
+	SightRadii.Empty();
+	PromotedEnemies.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UC_WS_EnemyCrowd::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UC_WS_EnemyCrowd::RemoveAtSwap(const int32 Index)
+{
+	EnemyClasses.RemoveAtSwap(Index);
+	Locations.RemoveAtSwap(Index);
+	Yaws.RemoveAtSwap(Index);
+	Levels.RemoveAtSwap(Index);
+	CurrentHPs.RemoveAtSwap(Index);
+	SightDistances.RemoveAtSwap(Index);
+	SightRadii.RemoveAtSwap(Index);
+}
@@ -0,0 +1,101 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "C_WS_EnemyCrowd.generated.h"
+
+class AC_EnemyCharacter;
+
+/**
+ * World Subsystem that keeps background enemies as plain data instead of Actors.
+ * Every crowd member lives in contiguous arrays (transform, stats, sight) that are tested in a single pass;
+ * members are promoted to a real AC_EnemyCharacter once they get within combat range of the player,
+ * and promoted enemies that wander far away without having found the player are demoted back into data.
+ * Promoted enemies that were defeated are dropped instead, so they never come back.
+ */
+UCLASS(config=Game)
+class TOAS_API UC_WS_EnemyCrowd : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Adds a crowd member that stays as data until the player comes close enough.
+	 * Its stats and sight values are taken from the defaults of the given class.
+	 * @param EnemyClass Enemy to spawn when the member is promoted (for example, a Blueprint of the Shadow enemy).
+	 * @param Transform World Transform of the member; only the location and yaw are kept.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Crowd_Functions")
+	void AddCrowdMember(TSubclassOf<AC_EnemyCharacter> EnemyClass, const FTransform& Transform);
+
+	// Amount of enemies currently kept as data.
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Crowd_Functions")
+	int32 GetNumCrowdMembers() const { return EnemyClasses.Num(); }
+
+	// Amount of crowd members currently promoted to Actors.
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Crowd_Functions")
+	int32 GetNumPromotedMembers() const { return PromotedEnemies.Num(); }
+
+	// Tests every member against the player, promoting and demoting them as needed.
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+protected:
+	// Crowds only exist in game worlds.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Distance to the player (in cm) under which a member is promoted to an Actor.
+	UPROPERTY(Config)
+	float PromotionDistance = 2500.0f;
+
+	// Distance to the player (in cm) over which a promoted enemy that hasn't found the player is demoted again.
+	// Kept above PromotionDistance so enemies on the border don't spawn and despawn every frame.
+	UPROPERTY(Config)
+	float DemotionDistance = 3500.0f;
+
+	// Maximum amount of members promoted per frame; spawning is expensive, the rest wait for the next frames.
+	UPROPERTY(Config)
+	int32 PromotionBudget = 2;
+
+private:
+	// Spawns the Actor of the member at the given index and removes it from the crowd.
+	void PromoteMember(const int32 Index);
+
+	// Stores the state of a promoted enemy back into the crowd and destroys its Actor.
+	void DemoteEnemy(AC_EnemyCharacter* Enemy);
+
+	// Removes the member at the given index from every array, keeping them packed.
+	void RemoveAtSwap(const int32 Index);
+
+	// Class spawned by each member; every array below shares its indices.
+	UPROPERTY()
+	TArray<TSubclassOf<AC_EnemyCharacter>> EnemyClasses;
+
+	// World Location of each member.
+	TArray<FVector> Locations;
+
+	// Yaw (in degrees) of each member.
+	TArray<float> Yaws;
+
+	// Level of each member, restored into the Stats Component when promoted.
+	TArray<uint8> Levels;
+
+	// Current Hit Points of each member, restored into the Stats Component when promoted.
+	TArray<uint8> CurrentHPs;
+
+	// SightDistance of each member.
+	TArray<float> SightDistances;
+
+	// SightRadius of each member.
+	TArray<float> SightRadii;
+
+	// Enemies spawned out of the crowd, which may be demoted back into it.
+	TArray<TWeakObjectPtr<AC_EnemyCharacter>> PromotedEnemies;
+};
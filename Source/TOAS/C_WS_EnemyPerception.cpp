@@ -0,0 +1,213 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_WS_EnemyPerception.h"
+#include "C_EnemyCharacter.h"
+#include "TOAS.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Perception"), STAT_TOAS_EnemyPerception, STATGROUP_TOAS);
+
+void UC_WS_EnemyPerception::RegisterEnemy(AC_EnemyCharacter* Enemy)
+{
+	if (IsValid(Enemy) == false || IsRegistered(Enemy) == true)
+	{
+		return;
+	}
+
+	Enemy->SetPerceptionIndex(Enemies.Add(Enemy));
+	SightCenters.Add(FVector::ZeroVector);
+	SightOrigins.Add(FVector::ZeroVector);
+	SightDistances.Add(Enemy->GetSightDistance());
+	SightRadii.Add(Enemy->GetSightRadius());
+	NeedsLineOfSight.Add(Enemy->NeedsLineOfSight());
+	IsAwake.Add(false);
+}
+
+void UC_WS_EnemyPerception::UnregisterEnemy(AC_EnemyCharacter* Enemy)
+{
+	if (IsRegistered(Enemy) == true)
+	{
+		RemoveAtSwap(Enemy->GetPerceptionIndex());
+	}
+}
+
+bool UC_WS_EnemyPerception::IsRegistered(const AC_EnemyCharacter* Enemy) const
+{
+	// Every enemy keeps its own index, so checking doesn't search the arrays.
+	const int32 Index = Enemy != nullptr ? Enemy->GetPerceptionIndex() : INDEX_NONE;
+	return Enemies.IsValidIndex(Index) == true && Enemies[Index].Get() == Enemy;
+}
+
+void UC_WS_EnemyPerception::Tick(float DeltaTime)
+{
+	TOAS_SCOPE(EnemyPerception);
+
+	Super::Tick(DeltaTime);
+
+	const ACharacter* Player = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+	if (Player == nullptr || Enemies.Num() == 0)
+	{
+		return;
+	}
+
+	const FVector PlayerLocation = Player->GetActorLocation();
+	float PlayerRadius = 0.0f;
+	float PlayerHalfHeight = 0.0f;
+	Player->GetCapsuleComponent()->GetScaledCapsuleSize(PlayerRadius, PlayerHalfHeight);
+	// Half length of the segment in the middle of the player's capsule.
+	const float PlayerSegmentHalfLength = FMath::Max(PlayerHalfHeight - PlayerRadius, 0.0f);
+
+	// First pass: only enemies close enough to the player read their SightOrigin socket this frame.
+	for (int32 Index = Enemies.Num() - 1; Index >= 0; --Index)
+	{
+		AC_EnemyCharacter* Enemy = Enemies[Index].Get();
+		if (Enemy == nullptr)
+		{
+			RemoveAtSwap(Index);
+			continue;
+		}
+
+		IsAwake[Index] = false;
+
+		// Enemies that already found the player stop looking for them.
+		if (Enemy->HasFoundPlayer() == true)
+		{
+			continue;
+		}
+
+		// Sight values are editable from Blueprints at any time, so they are refreshed along the coarse check.
+		SightDistances[Index] = Enemy->GetSightDistance();
+		SightRadii[Index] = Enemy->GetSightRadius();
+		NeedsLineOfSight[Index] = Enemy->NeedsLineOfSight();
+
+		const float ReachFromActor = SightDistances[Index] + SightRadii[Index] + PlayerHalfHeight + SightOriginSlack;
+		if (FVector::DistSquared(Enemy->GetActorLocation(), PlayerLocation) > FMath::Square(ReachFromActor))
+		{
+			continue;
+		}
+
+		FTransform SightTransform;
+		if (Enemy->GetSightTransform(SightTransform) == false)
+		{
+			continue;
+		}
+
+		SightOrigins[Index] = SightTransform.GetLocation();
+		SightCenters[Index] = SightOrigins[Index] + SightTransform.GetRotation().GetForwardVector() * SightDistances[Index];
+		IsAwake[Index] = true;
+	}
+
+	// Second pass: a tight loop over the packed arrays, testing each sight sphere against the player's capsule.
+	OcclusionCandidates.Reset();
+	const int32 NumEnemies = Enemies.Num();
+	for (int32 Index = 0; Index < NumEnemies; ++Index)
+	{
+		// Closest point of the capsule's inner segment to the sight center.
+		const FVector& Center = SightCenters[Index];
+		const FVector ClosestPoint(PlayerLocation.X, PlayerLocation.Y,
+			FMath::Clamp(Center.Z, PlayerLocation.Z - PlayerSegmentHalfLength, PlayerLocation.Z + PlayerSegmentHalfLength));
+		const float Reach = SightRadii[Index] + PlayerRadius;
+		const bool bInSight = IsAwake[Index] && FVector::DistSquared(Center, ClosestPoint) <= Reach * Reach;
+
+		if (bInSight)
+		{
+			OcclusionCandidates.Add(Index);
+		}
+	}
+
+	if (OcclusionCandidates.Num() == 0)
+	{
+		return;
+	}
+
+	// Last pass: enemies that need line of sight are traced, but only up to the budget for this frame.
+	int32 TracesLeft = OcclusionTraceBudget;
+	const int32 NumCandidates = OcclusionCandidates.Num();
+	const int32 FirstCandidate = OcclusionCursor % NumCandidates;
+
+	for (int32 Offset = 0; Offset < NumCandidates; ++Offset)
+	{
+		const int32 Index = OcclusionCandidates[(FirstCandidate + Offset) % NumCandidates];
+		AC_EnemyCharacter* Enemy = Enemies[Index].Get();
+
+		if (NeedsLineOfSight[Index] == true)
+		{
+			if (TracesLeft <= 0)
+			{
+				continue;
+			}
+			--TracesLeft;
+			++OcclusionCursor;
+			++TOASCounters::PerceptionTraces;
+
+			FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TOASEnemySight), false, Enemy);
+			QueryParams.AddIgnoredActor(Player);
+
+			// Anything blocking visibility between the eyes and the player hides them.
+			if (GetWorld()->LineTraceTestByChannel(SightOrigins[Index], PlayerLocation, ECC_Visibility, QueryParams))
+			{
+				continue;
+			}
+		}
+
+		Enemy->NotifyPlayerFound();
+	}
+}
+
+TStatId UC_WS_EnemyPerception::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UC_WS_EnemyPerception, STATGROUP_Tickables);
+}
+
+void UC_WS_EnemyPerception::Deinitialize()
+{
+	for (const TWeakObjectPtr<AC_EnemyCharacter>& Enemy : Enemies)
+	{
+		if (Enemy.IsValid() == true)
+		{
+			Enemy->SetPerceptionIndex(INDEX_NONE);
+		}
+	}
+	Enemies.Empty();
+	SightCenters.Empty();
+	SightOrigins.Empty();
+	SightDistances.Empty();
+	SightRadii.Empty();
+	NeedsLineOfSight.Empty();
+	IsAwake.Empty();
+	OcclusionCandidates.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UC_WS_EnemyPerception::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UC_WS_EnemyPerception::RemoveAtSwap(const int32 Index)
+{
+	if (AC_EnemyCharacter* Removed = Enemies[Index].Get())
+	{
+		Removed->SetPerceptionIndex(INDEX_NONE);
+	}
+
+	Enemies.RemoveAtSwap(Index);
+	// The last enemy was moved into the freed index.
+	if (Enemies.IsValidIndex(Index) == true && Enemies[Index].IsValid() == true)
+	{
+		Enemies[Index]->SetPerceptionIndex(Index);
+	}
+	SightCenters.RemoveAtSwap(Index);
+	SightOrigins.RemoveAtSwap(Index);
+	SightDistances.RemoveAtSwap(Index);
+	SightRadii.RemoveAtSwap(Index);
+	NeedsLineOfSight.RemoveAtSwap(Index);
+	IsAwake.RemoveAtSwap(Index);
+}
@@ -0,0 +1,83 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "C_WS_EnemyPerception.generated.h"
+
+class AC_EnemyCharacter;
+
+/**
+ * World Subsystem that looks for the player on behalf of every registered enemy.
+ * Sight parameters are kept in contiguous arrays and tested against the player with a cheap sphere check;
+ * only the enemies that pass it and need line of sight are traced, within a fixed budget of traces per frame.
+ */
+UCLASS(config=Game)
+class TOAS_API UC_WS_EnemyPerception : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Adds an enemy to the perception arrays; it stops tracing for the player on its own.
+	void RegisterEnemy(AC_EnemyCharacter* Enemy);
+
+	// Removes an enemy from the perception arrays.
+	void UnregisterEnemy(AC_EnemyCharacter* Enemy);
+
+	// Checks if the enemy is being handled by this subsystem.
+	bool IsRegistered(const AC_EnemyCharacter* Enemy) const;
+
+	// Updates the sight of every enemy and tests it against the player.
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+protected:
+	// Perception only happens in game worlds.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Maximum amount of line of sight traces done per frame; the rest wait for the next frames.
+	UPROPERTY(Config)
+	int32 OcclusionTraceBudget = 4;
+
+	// Extra distance added to the coarse check on the enemy's location, to account for the head's offset.
+	UPROPERTY(Config)
+	float SightOriginSlack = 200.0f;
+
+private:
+	// Removes the enemy at the given index from every array, keeping them packed.
+	void RemoveAtSwap(const int32 Index);
+
+	// Every registered enemy; every array below shares its indices.
+	TArray<TWeakObjectPtr<AC_EnemyCharacter>> Enemies;
+
+	// Center of each enemy's sight sphere (SightOrigin + Forward * SightDistance), updated every frame.
+	TArray<FVector> SightCenters;
+
+	// Location of each enemy's SightOrigin socket, updated every frame; used for line of sight traces.
+	TArray<FVector> SightOrigins;
+
+	// SightDistance of each enemy, refreshed every frame along the coarse check.
+	TArray<float> SightDistances;
+
+	// SightRadius of each enemy, refreshed along its SightDistance.
+	TArray<float> SightRadii;
+
+	// Whether each enemy needs a clear line of sight to the player once it's inside its sight sphere;
+	// refreshed along its SightDistance.
+	TArray<bool> NeedsLineOfSight;
+
+	// Whether each enemy's sight was updated this frame (it may be too far from the player to bother).
+	TArray<bool> IsAwake;
+
+	// Indices of the enemies that passed the sphere check and wait for a line of sight trace.
+	TArray<int32> OcclusionCandidates;
+
+	// Rotates which candidates get traced first, so every enemy is eventually traced when over budget.
+	int32 OcclusionCursor = 0;
+};
@@ -0,0 +1,114 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_WS_EnemySignificance.h"
+#include "TOAS.h"
+#include "C_EnemyCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Significance"), STAT_TOAS_EnemySignificance, STATGROUP_TOAS);
+
+void UC_WS_EnemySignificance::RegisterEnemy(AC_EnemyCharacter* Enemy)
+{
+	if (IsValid(Enemy) == false || Enemies.Contains(Enemy) == true)
+	{
+		return;
+	}
+
+	Enemies.Add(Enemy);
+
+	// New enemies are evaluated on the next frame instead of waiting for the whole interval.
+	TimeSinceEvaluation = EvaluationInterval;
+}
+
+void UC_WS_EnemySignificance::UnregisterEnemy(AC_EnemyCharacter* Enemy)
+{
+	Enemies.RemoveSwap(Enemy);
+}
+
+void UC_WS_EnemySignificance::Tick(float DeltaTime)
+{
+	TOAS_SCOPE(EnemySignificance);
+
+	Super::Tick(DeltaTime);
+
+	TimeSinceEvaluation += DeltaTime;
+	if (TimeSinceEvaluation < EvaluationInterval)
+	{
+		return;
+	}
+	TimeSinceEvaluation = 0.0f;
+
+	const ACharacter* Player = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+	if (Player == nullptr || Enemies.Num() == 0)
+	{
+		return;
+	}
+
+	const FVector PlayerLocation = Player->GetActorLocation();
+
+	for (int32 Index = Enemies.Num() - 1; Index >= 0; --Index)
+	{
+		AC_EnemyCharacter* Enemy = Enemies[Index].Get();
+		if (Enemy == nullptr)
+		{
+			Enemies.RemoveAtSwap(Index);
+			continue;
+		}
+
+		// Enemies fighting the player, or marked by the Z-Targeting System, always get the most significant tier.
+		if (Enemy->HasFoundPlayer() == true || Enemy->IsMarkedForTargeting() == true)
+		{
+			Enemy->SetSignificanceTier(0);
+			continue;
+		}
+
+		float Distance = FVector::Dist(Enemy->GetActorLocation(), PlayerLocation);
+		if (Enemy->WasRecentlyRendered(OffscreenGracePeriod) == false)
+		{
+			Distance *= OffscreenDistanceScale;
+		}
+
+		Enemy->SetSignificanceTier(ComputeTier(Enemy, Distance));
+	}
+}
+
+int32 UC_WS_EnemySignificance::ComputeTier(const AC_EnemyCharacter* Enemy, const float Distance) const
+{
+	const TArray<FSignificanceTier>& Tiers = Enemy->GetSignificanceTiers();
+	const int32 CurrentTier = Enemy->GetSignificanceTier();
+
+	for (int32 TierIndex = 0; TierIndex < Tiers.Num(); ++TierIndex)
+	{
+		// The current tier is kept a little longer, to avoid flickering on its border.
+		const float Slack = (TierIndex == CurrentTier) ? TierHysteresis : 0.0f;
+		if (Distance <= Tiers[TierIndex].MaxDistance + Slack)
+		{
+			return TierIndex;
+		}
+	}
+
+	// Beyond every tier, the least significant one is used.
+	return Tiers.Num() - 1;
+}
+
+TStatId UC_WS_EnemySignificance::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UC_WS_EnemySignificance, STATGROUP_Tickables);
+}
+
+void UC_WS_EnemySignificance::Deinitialize()
+{
+	Enemies.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UC_WS_EnemySignificance::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,67 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "C_WS_EnemySignificance.generated.h"
+
+class AC_EnemyCharacter;
+
+/**
+ * World Subsystem that ranks every registered enemy by how much it matters to the player right now.
+ * Significance comes from the distance to the player, whether the enemy was rendered recently and its combat state;
+ * each enemy then applies the Significance Tier it falls into (tick rates, animation and widgets).
+ */
+UCLASS(config=Game)
+class TOAS_API UC_WS_EnemySignificance : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Adds an enemy to the significance evaluation.
+	void RegisterEnemy(AC_EnemyCharacter* Enemy);
+
+	// Removes an enemy from the significance evaluation.
+	void UnregisterEnemy(AC_EnemyCharacter* Enemy);
+
+	// Evaluates the significance of every enemy, once every EvaluationInterval seconds.
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+protected:
+	// Significance only matters in game worlds.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Seconds between evaluations; tiers don't need to react faster than this.
+	UPROPERTY(Config)
+	float EvaluationInterval = 0.25f;
+
+	// Multiplier applied to the distance of enemies that weren't rendered recently, so they drop tiers sooner.
+	UPROPERTY(Config)
+	float OffscreenDistanceScale = 2.0f;
+
+	// Seconds without being rendered before an enemy counts as offscreen.
+	UPROPERTY(Config)
+	float OffscreenGracePeriod = 0.5f;
+
+	// Extra distance an enemy must travel past its tier before dropping to a less significant one,
+	// so enemies standing on a border don't swap tiers every evaluation.
+	UPROPERTY(Config)
+	float TierHysteresis = 150.0f;
+
+private:
+	// Obtains the index of the tier the enemy belongs to at the given (scaled) distance.
+	int32 ComputeTier(const AC_EnemyCharacter* Enemy, const float Distance) const;
+
+	// Every registered enemy.
+	TArray<TWeakObjectPtr<AC_EnemyCharacter>> Enemies;
+
+	// Time accumulated since the last evaluation.
+	float TimeSinceEvaluation = 0.0f;
+};
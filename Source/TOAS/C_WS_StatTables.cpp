@@ -0,0 +1,117 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_WS_StatTables.h"
+#include "C_StructsAndEnums.h"
+#include "TOASCharacter.h"
+#include "Algo/UpperBound.h"
+#include "Engine/DataTable.h"
+
+namespace StatTables
+{
+	// Same cap used by the Stats Component for the Experience pool.
+	constexpr int32 MaxEXP = 9999999;
+
+	// Interpolates a stat between two rows.
+	uint8 Lerp(const uint8 From, const uint8 To, const float Alpha)
+	{
+		return static_cast<uint8>(FMath::RoundToInt(FMath::Lerp<float>(From, To, Alpha)));
+	}
+}
+
+int32 FStatGrowthTable::GetEXPCap(const uint8 Level) const
+{
+	// The last level keeps every Experience point that can be obtained.
+	if (Level >= MaxLevel)
+	{
+		return StatTables::MaxEXP;
+	}
+	return TotalEXPs[Level + 1] - 1;
+}
+
+uint8 FStatGrowthTable::GetLevelForEXP(const int32 EXP) const
+{
+	// The first level needing more than EXP is one above the reached level.
+	const int32 NextLevel = Algo::UpperBound(TotalEXPs, EXP);
+	return static_cast<uint8>(FMath::Clamp(NextLevel - 1, 1, static_cast<int32>(MaxLevel)));
+}
+
+FStatGrowthTable FStatGrowthTable::Bake(const UDataTable& GrowthTable)
+{
+	TArray<FStatGrowthRow*> Rows;
+	GrowthTable.GetAllRows(TEXT("FStatGrowthTable::Bake"), Rows);
+	Rows.Sort([](const FStatGrowthRow& A, const FStatGrowthRow& B) { return A.Level < B.Level; });
+
+	FStatGrowthTable Table;
+
+	if (Rows.Num() == 0)
+	{
+		UE_LOG(LogTemplateCharacter, Warning, TEXT("Growth table %s has no rows."), *GrowthTable.GetName());
+		Table.Blocks.AddDefaulted(2);
+		Table.TotalEXPs.AddZeroed(2);
+		return Table;
+	}
+
+	Table.MaxLevel = FMath::Max<uint8>(Rows.Last()->Level, 1);
+	Table.Blocks.SetNum(Table.MaxLevel + 1);
+	Table.TotalEXPs.SetNumZeroed(Table.MaxLevel + 1);
+
+	int32 RowIndex = 0;
+	for (int32 Level = 1; Level <= Table.MaxLevel; ++Level)
+	{
+		while (RowIndex + 1 < Rows.Num() && Rows[RowIndex + 1]->Level <= Level)
+		{
+			++RowIndex;
+		}
+
+		// Levels before the first row use it as is; the rest blend towards the next row.
+		const FStatGrowthRow& From = *Rows[RowIndex];
+		const FStatGrowthRow& To = *Rows[FMath::Min(RowIndex + 1, Rows.Num() - 1)];
+		const float Alpha = To.Level > From.Level
+			? FMath::Clamp(static_cast<float>(Level - From.Level) / (To.Level - From.Level), 0.0f, 1.0f)
+			: 0.0f;
+
+		FStatBlock& Block = Table.Blocks[Level];
+		Block.MaxHP = StatTables::Lerp(From.MaxHP, To.MaxHP, Alpha);
+		Block.ATK = StatTables::Lerp(From.ATK, To.ATK, Alpha);
+		Block.DEF = StatTables::Lerp(From.DEF, To.DEF, Alpha);
+		Block.Resistances[static_cast<uint8>(EElementalAttribute::FIRE)] =
+			StatTables::Lerp(From.FireRES, To.FireRES, Alpha);
+		Block.Resistances[static_cast<uint8>(EElementalAttribute::ICE)] =
+			StatTables::Lerp(From.IceRES, To.IceRES, Alpha);
+		Block.Resistances[static_cast<uint8>(EElementalAttribute::THUNDER)] =
+			StatTables::Lerp(From.ThunderRES, To.ThunderRES, Alpha);
+		Block.Resistances[static_cast<uint8>(EElementalAttribute::DARK)] =
+			StatTables::Lerp(From.DarkRES, To.DarkRES, Alpha);
+
+		// Level 1 needs no Experience, and thresholds never go down, so lookups can binary search them.
+		const int32 EXP = Level == 1 ? 0
+			: FMath::RoundToInt(FMath::Lerp<float>(From.TotalEXP, To.TotalEXP, Alpha));
+		Table.TotalEXPs[Level] = FMath::Clamp(EXP, Table.TotalEXPs[Level - 1], StatTables::MaxEXP);
+	}
+
+	Table.Blocks[0] = Table.Blocks[1];
+
+	return Table;
+}
+
+TSharedRef<const FStatGrowthTable> UC_WS_StatTables::FindOrBake(const UDataTable& GrowthTable)
+{
+	if (const TSharedRef<const FStatGrowthTable>* Baked = BakedTables.Find(&GrowthTable))
+	{
+		return *Baked;
+	}
+
+	TSharedRef<const FStatGrowthTable> Baked = MakeShared<FStatGrowthTable>(FStatGrowthTable::Bake(GrowthTable));
+	BakedTables.Add(&GrowthTable, Baked);
+	return Baked;
+}
+
+void UC_WS_StatTables::Deinitialize()
+{
+	BakedTables.Empty();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,71 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "C_StructsAndEnums.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "C_WS_StatTables.generated.h"
+
+class UDataTable;
+
+// Stats of a character at a single level.
+struct FStatBlock
+{
+	uint8 MaxHP = 10;
+	uint8 ATK = 5;
+	uint8 DEF = 2;
+	// Indexed by element, like the Stats Component's resistances.
+	uint8 Resistances[ElementCount] = {};
+};
+
+/**
+ * Growth Data Table baked into flat arrays indexed by level, so stat and Experience queries are plain lookups.
+ * Index 0 is a copy of level 1, so any uint8 level up to MaxLevel can be used directly.
+ */
+struct TOAS_API FStatGrowthTable
+{
+	// Stats of every level.
+	TArray<FStatBlock> Blocks;
+
+	// Total Experience needed to reach every level; never decreases.
+	TArray<int32> TotalEXPs;
+
+	// Highest level described by the table.
+	uint8 MaxLevel = 1;
+
+	// Returns the stats of a level, clamped to the levels of the table.
+	const FStatBlock& GetBlock(const uint8 Level) const { return Blocks[FMath::Min(Level, MaxLevel)]; }
+
+	// Returns the most Experience a character can hold while staying at the given level.
+	int32 GetEXPCap(const uint8 Level) const;
+
+	// Returns the level reached with the given total Experience.
+	uint8 GetLevelForEXP(const int32 EXP) const;
+
+	// Bakes a Data Table of FStatGrowthRow, interpolating the levels between its rows.
+	static FStatGrowthTable Bake(const UDataTable& GrowthTable);
+};
+
+/**
+ * World Subsystem that bakes every growth Data Table used by the Stats Components once,
+ * so every character of the same class shares a single set of arrays instead of holding its own.
+ */
+UCLASS()
+class TOAS_API UC_WS_StatTables : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Returns the baked version of a growth Data Table, baking it on first use.
+	TSharedRef<const FStatGrowthTable> FindOrBake(const UDataTable& GrowthTable);
+
+	virtual void Deinitialize() override;
+
+private:
+	// Tables baked so far.
+	TMap<TObjectKey<UDataTable>, TSharedRef<const FStatGrowthTable>> BakedTables;
+};
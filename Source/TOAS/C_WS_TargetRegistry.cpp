@@ -0,0 +1,134 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_WS_TargetRegistry.h"
+#include "TOAS.h"
+#include "TOASCharacter.h"
+#include "C_AComp_Stats.h"
+#include "Components/CapsuleComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Rank Targets"), STAT_TOAS_RankTargets, STATGROUP_TOAS);
+
+void UC_WS_TargetRegistry::RegisterTargetable(ATOASCharacter* Character)
+{
+	if (IsValid(Character) == false || Targetables.Contains(Character) == true)
+	{
+		return;
+	}
+
+	Targetables.Add(Character);
+	RegistrationOrders.Add(NextRegistrationOrder++);
+	CapsuleRadii.Add(0.0f);
+	CapsuleHalfAxes.Add(FVector::ZeroVector);
+	Locations.Add(FVector::ZeroVector);
+	CanBeRanked.Add(false);
+	Scores.Add(-1.0f);
+}
+
+void UC_WS_TargetRegistry::UnregisterTargetable(ATOASCharacter* Character)
+{
+	const int32 Index = Targetables.IndexOfByKey(Character);
+	if (Index != INDEX_NONE)
+	{
+		RemoveAtSwap(Index);
+	}
+}
+
+void UC_WS_TargetRegistry::RankTargets(const ATOASCharacter* Seeker, const FVector& Origin,
+	const FVector& Direction, const float Distance, const float Radius, TArray<ATOASCharacter*>& OutRanked)
+{
+	TOAS_SCOPE(RankTargets);
+
+	OutRanked.Reset();
+
+	// First pass: gather what the scoring needs out of each character.
+	for (int32 Index = Targetables.Num() - 1; Index >= 0; --Index)
+	{
+		const ATOASCharacter* Character = Targetables[Index].Get();
+		if (Character == nullptr)
+		{
+			RemoveAtSwap(Index);
+			continue;
+		}
+
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		Locations[Index] = Capsule->GetComponentLocation();
+		CapsuleRadii[Index] = Capsule->GetScaledCapsuleRadius();
+		CapsuleHalfAxes[Index] = Capsule->GetUpVector() * Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere();
+		CanBeRanked[Index] = Character != Seeker && Character->GetStats()->GetCurrentHP() > 0;
+	}
+
+	// Second pass: a tight loop over the packed arrays, without branches depending on the characters.
+	const FVector End = Origin + Direction * Distance;
+	const int32 NumTargetables = Targetables.Num();
+	for (int32 Index = 0; Index < NumTargetables; ++Index)
+	{
+		const FVector ToCandidate = Locations[Index] - Origin;
+		const float CandidateDistance = ToCandidate.Size();
+
+		// Closest points between the area's segment and the candidate's capsule axis;
+		// the area touches its capsule within this reach, from its feet to its head.
+		FVector ClosestOnArea;
+		FVector ClosestOnCapsule;
+		FMath::SegmentDistToSegmentSafe(Origin, End, Locations[Index] - CapsuleHalfAxes[Index],
+			Locations[Index] + CapsuleHalfAxes[Index], ClosestOnArea, ClosestOnCapsule);
+		const float Reach = Radius + CapsuleRadii[Index];
+		const bool bInArea = CanBeRanked[Index]
+			&& FVector::DistSquared(ClosestOnArea, ClosestOnCapsule) <= Reach * Reach;
+
+		// 0 when the candidate is straight ahead, 2 when it's right behind.
+		const float AnglePenalty = 1.0f - (ToCandidate.GetSafeNormal() | Direction);
+		Scores[Index] = bInArea ? CandidateDistance * (1.0f + AngleWeight * AnglePenalty) : -1.0f;
+	}
+
+	RankedIndices.Reset();
+	for (int32 Index = 0; Index < NumTargetables; ++Index)
+	{
+		if (Scores[Index] >= 0.0f)
+		{
+			RankedIndices.Add(Index);
+		}
+	}
+
+	RankedIndices.Sort([this](const int32 A, const int32 B)
+	{
+		if (Scores[A] != Scores[B])
+		{
+			return Scores[A] < Scores[B];
+		}
+		return RegistrationOrders[A] < RegistrationOrders[B];
+	});
+
+	OutRanked.Reserve(RankedIndices.Num());
+	for (const int32 Index : RankedIndices)
+	{
+		OutRanked.Add(Targetables[Index].Get());
+	}
+}
+
+void UC_WS_TargetRegistry::Deinitialize()
+{
+	Targetables.Empty();
+	RegistrationOrders.Empty();
+	CapsuleRadii.Empty();
+	CapsuleHalfAxes.Empty();
+	Locations.Empty();
+	CanBeRanked.Empty();
+	Scores.Empty();
+	RankedIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+void UC_WS_TargetRegistry::RemoveAtSwap(const int32 Index)
+{
+	Targetables.RemoveAtSwap(Index);
+	RegistrationOrders.RemoveAtSwap(Index);
+	CapsuleRadii.RemoveAtSwap(Index);
+	CapsuleHalfAxes.RemoveAtSwap(Index);
+	Locations.RemoveAtSwap(Index);
+	CanBeRanked.RemoveAtSwap(Index);
+	Scores.RemoveAtSwap(Index);
+}
@@ -0,0 +1,82 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "C_WS_TargetRegistry.generated.h"
+
+class ATOASCharacter;
+
+/**
+ * World Subsystem that keeps every character that can be seen or targeted by the Z-Targeting System.
+ * Candidates are scored in a single pass over packed arrays, without any physics query,
+ * and returned ranked from best to worst in an order that doesn't change between runs.
+ */
+UCLASS(config=Game)
+class TOAS_API UC_WS_TargetRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Adds a character to the registry, so it can be seen and targeted.
+	void RegisterTargetable(ATOASCharacter* Character);
+
+	// Removes a character from the registry.
+	void UnregisterTargetable(ATOASCharacter* Character);
+
+	/**
+	 * Ranks the living characters inside the Z-Targeting area, which matches the sphere sweep it replaces:
+	 * a capsule going from Origin towards Direction.
+	 * Candidates are sorted by distance, weighted by their angle from Direction; ties keep the registration order.
+	 * @param Seeker Character looking for targets; it never ranks itself.
+	 * @param Origin World Location where the area begins.
+	 * @param Direction Normalized direction of the area, usually the control yaw.
+	 * @param Distance Length of the area.
+	 * @param Radius Radius of the area.
+	 * @param OutRanked Candidates from best to worst; emptied before being filled.
+	 */
+	void RankTargets(const ATOASCharacter* Seeker, const FVector& Origin, const FVector& Direction,
+		const float Distance, const float Radius, TArray<ATOASCharacter*>& OutRanked);
+
+	virtual void Deinitialize() override;
+
+protected:
+	// How much the angle from Direction weighs on the score; 0 ranks by distance only.
+	UPROPERTY(Config)
+	float AngleWeight = 1.0f;
+
+private:
+	// Removes the character at the given index from every array, keeping them packed.
+	void RemoveAtSwap(const int32 Index);
+
+	// Every registered character; every array below shares its indices.
+	TArray<TWeakObjectPtr<ATOASCharacter>> Targetables;
+
+	// Order in which each character was registered, used to break ties deterministically.
+	TArray<uint32> RegistrationOrders;
+
+	// Radius of each character's capsule, gathered at the beginning of every ranking,
+	// so the area touches them the same way the sweep did even after their capsule is resized.
+	TArray<float> CapsuleRadii;
+
+	// Half of the segment running through each character's capsule, from its center to the center of its top sphere.
+	TArray<FVector> CapsuleHalfAxes;
+
+	// Location of each character's capsule, gathered along its size.
+	TArray<FVector> Locations;
+
+	// Whether each character is alive and may be ranked, gathered along the locations.
+	TArray<bool> CanBeRanked;
+
+	// Score of each character, written by the ranking pass; lower is better, negative means out of the area.
+	TArray<float> Scores;
+
+	// Indices of the characters inside the area, sorted by score.
+	TArray<int32> RankedIndices;
+
+	// Order given to the next registered character.
+	uint32 NextRegistrationOrder = 0;
+};
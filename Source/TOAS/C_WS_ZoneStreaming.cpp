@@ -0,0 +1,332 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_WS_ZoneStreaming.h"
+#include "TOAS.h"
+#include "C_GI_GameManager.h"
+#include "C_StructsAndEnums.h"
+#include "TOASCharacter.h"
+#include "Engine/DataTable.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Zone Streaming"), STAT_TOAS_ZoneStreaming, STATGROUP_TOAS);
+
+namespace
+{
+	// Share of a zone's progress filled by loading; becoming visible fills the rest.
+	constexpr float LoadedProgress = 0.8f;
+}
+
+void UC_WS_ZoneStreaming::SetZoneGraph(const UDataTable* ZoneTable)
+{
+	Zones.Reset();
+	ZoneIndexByName.Reset();
+	CurrentZone = INDEX_NONE;
+
+	if (ZoneTable == nullptr)
+	{
+		return;
+	}
+
+	TArray<FZoneRow*> Rows;
+	ZoneTable->GetAllRows(TEXT("UC_WS_ZoneStreaming::SetZoneGraph"), Rows);
+	const TArray<FName> RowNames = ZoneTable->GetRowNames();
+	if (Rows.Num() != RowNames.Num())
+	{
+		return;
+	}
+
+	Zones.Reserve(Rows.Num());
+	for (int32 Index = 0; Index < Rows.Num(); ++Index)
+	{
+		FZone& Zone = Zones.AddDefaulted_GetRef();
+		Zone.Name = RowNames[Index];
+		Zone.PackageName = Rows[Index]->Level.ToSoftObjectPath().GetLongPackageFName();
+		Zone.Bounds = Rows[Index]->Bounds;
+		ZoneIndexByName.Add(Zone.Name, Index);
+	}
+
+	// Neighbours are resolved into indices once every zone has one.
+	for (int32 Index = 0; Index < Rows.Num(); ++Index)
+	{
+		for (const FName& Neighbour : Rows[Index]->Neighbours)
+		{
+			if (const int32* NeighbourIndex = ZoneIndexByName.Find(Neighbour))
+			{
+				Zones[Index].Neighbours.AddUnique(*NeighbourIndex);
+			}
+			else
+			{
+				UE_LOG(LogTemplateCharacter, Warning, TEXT("Zone %s lists unknown neighbour %s."),
+					*Zones[Index].Name.ToString(), *Neighbour.ToString());
+			}
+		}
+	}
+
+	// The first prediction happens on the next frame instead of waiting for the whole interval.
+	TimeSincePrediction = PredictionInterval;
+}
+
+void UC_WS_ZoneStreaming::RequestZone(const FName Zone)
+{
+	if (const int32* Index = ZoneIndexByName.Find(Zone))
+	{
+		Zones[*Index].bRequested = true;
+		TimeSincePrediction = PredictionInterval;
+	}
+}
+
+float UC_WS_ZoneStreaming::GetZoneProgress(const FName Zone) const
+{
+	const int32* Index = ZoneIndexByName.Find(Zone);
+	const ULevelStreaming* Streaming = Index != nullptr ? Zones[*Index].Streaming.Get() : nullptr;
+	if (Streaming == nullptr)
+	{
+		return 0.0f;
+	}
+
+	switch (Streaming->GetLevelStreamingState())
+	{
+	case ELevelStreamingState::Loading:
+		// The percentage is negative while the package waits to start loading.
+		return LoadedProgress * FMath::Max(GetAsyncLoadPercentage(Streaming->GetWorldAssetPackageFName()), 0.0f)
+			/ 100.0f;
+	case ELevelStreamingState::LoadedNotVisible:
+	case ELevelStreamingState::MakingInvisible:
+		return LoadedProgress;
+	case ELevelStreamingState::MakingVisible:
+		return (LoadedProgress + 1.0f) * 0.5f;
+	case ELevelStreamingState::LoadedVisible:
+		return 1.0f;
+	default:
+		return 0.0f;
+	}
+}
+
+FName UC_WS_ZoneStreaming::GetCurrentZone() const
+{
+	return Zones.IsValidIndex(CurrentZone) == true ? Zones[CurrentZone].Name : NAME_None;
+}
+
+void UC_WS_ZoneStreaming::Tick(float DeltaTime)
+{
+	TOAS_SCOPE(ZoneStreaming);
+
+	Super::Tick(DeltaTime);
+
+	if (Zones.Num() == 0)
+	{
+		return;
+	}
+
+	TimeSincePrediction += DeltaTime;
+	if (TimeSincePrediction >= PredictionInterval)
+	{
+		TimeSincePrediction = 0.0f;
+		Predict();
+	}
+
+	ApplyTargets();
+}
+
+ULevelStreaming* UC_WS_ZoneStreaming::GetStreaming(FZone& Zone) const
+{
+	if (Zone.Streaming.IsValid() == false && Zone.PackageName.IsNone() == false)
+	{
+		Zone.Streaming = UGameplayStatics::GetStreamingLevel(GetWorld(), Zone.PackageName);
+	}
+	return Zone.Streaming.Get();
+}
+
+int32 UC_WS_ZoneStreaming::FindZoneAt(const FVector& Point) const
+{
+	// Zones may overlap on their borders; the current one is kept until the player fully leaves it.
+	if (Zones.IsValidIndex(CurrentZone) == true && Zones[CurrentZone].Bounds.IsInsideOrOn(Point) == true)
+	{
+		return CurrentZone;
+	}
+
+	for (int32 Index = 0; Index < Zones.Num(); ++Index)
+	{
+		if (Zones[Index].Bounds.IsInsideOrOn(Point) == true)
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void UC_WS_ZoneStreaming::Predict()
+{
+	const ACharacter* Player = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+	if (Player == nullptr)
+	{
+		return;
+	}
+
+	const FVector Location = Player->GetActorLocation();
+	const FVector Predicted = Location + Player->GetVelocity() * LookAheadTime;
+
+	const int32 PreviousZone = CurrentZone;
+	CurrentZone = FindZoneAt(Location);
+	if (CurrentZone != PreviousZone)
+	{
+		const FName PreviousName = Zones.IsValidIndex(PreviousZone) == true ? Zones[PreviousZone].Name : NAME_None;
+		if (Zones.IsValidIndex(CurrentZone) == true)
+		{
+			Zones[CurrentZone].bRequested = false;
+
+			// Slot lists show the zone the game was saved in.
+			if (UC_GI_GameManager* GameManager = Cast<UC_GI_GameManager>(GetWorld()->GetGameInstance()))
+			{
+				GameManager->SetLastZone(Zones[CurrentZone].Name);
+			}
+		}
+		OnZoneEntered.Broadcast(PreviousName, GetCurrentZone());
+	}
+
+	// Only the neighbours of the current zone can be reached next; outside of every zone, any of them can.
+	TBitArray<> Reachable(Zones.IsValidIndex(CurrentZone) == false, Zones.Num());
+	if (Zones.IsValidIndex(CurrentZone) == true)
+	{
+		for (const int32 Neighbour : Zones[CurrentZone].Neighbours)
+		{
+			Reachable[Neighbour] = true;
+		}
+	}
+
+	const FVector Halfway = (Location + Predicted) * 0.5f;
+	const float PrefetchDistanceSquared = FMath::Square(PrefetchDistance);
+	const float ActivationDistanceSquared = FMath::Square(ActivationDistance);
+	const float UnloadDistanceSquared = FMath::Square(UnloadDistance);
+
+	for (int32 Index = 0; Index < Zones.Num(); ++Index)
+	{
+		FZone& Zone = Zones[Index];
+		const float DistanceSquared = Zone.Bounds.ComputeSquaredDistanceToPoint(Location);
+
+		// Fast players may cross a zone before the predicted position reaches it, so the path is sampled too.
+		const float PathDistanceSquared = FMath::Min3(DistanceSquared,
+			Zone.Bounds.ComputeSquaredDistanceToPoint(Halfway), Zone.Bounds.ComputeSquaredDistanceToPoint(Predicted));
+		Zone.PathDistanceSquared = PathDistanceSquared;
+
+		EZoneTarget Target = EZoneTarget::Unloaded;
+		if (Index == CurrentZone || Zone.bRequested == true)
+		{
+			Target = EZoneTarget::Visible;
+		}
+		else if (Reachable[Index] == true && (PathDistanceSquared <= ActivationDistanceSquared
+			|| (Zone.Target == EZoneTarget::Visible && PathDistanceSquared <= PrefetchDistanceSquared)))
+		{
+			// Shown zones stay shown while in prefetch range, so turning around on a border doesn't flicker them.
+			Target = EZoneTarget::Visible;
+		}
+		else if (Reachable[Index] == true && PathDistanceSquared <= PrefetchDistanceSquared)
+		{
+			Target = EZoneTarget::Loaded;
+		}
+		else if (Zone.Target != EZoneTarget::Unloaded && DistanceSquared <= UnloadDistanceSquared)
+		{
+			Target = EZoneTarget::Loaded;
+		}
+		Zone.Target = Target;
+	}
+}
+
+void UC_WS_ZoneStreaming::ApplyTargets()
+{
+	bool bVisibilityChanging = false;
+	int32 ZoneToShow = INDEX_NONE;
+	int32 ZoneToHide = INDEX_NONE;
+
+	for (int32 Index = 0; Index < Zones.Num(); ++Index)
+	{
+		FZone& Zone = Zones[Index];
+		ULevelStreaming* Streaming = GetStreaming(Zone);
+		if (Streaming == nullptr)
+		{
+			continue;
+		}
+
+		const ELevelStreamingState State = Streaming->GetLevelStreamingState();
+		bVisibilityChanging |= State == ELevelStreamingState::MakingVisible
+			|| State == ELevelStreamingState::MakingInvisible;
+
+		// Loading happens on the async loading thread, so every load is requested right away.
+		// Zones are only unloaded once hidden.
+		const bool bShouldBeLoaded = Zone.Target != EZoneTarget::Unloaded;
+		if (Streaming->ShouldBeLoaded() != bShouldBeLoaded
+			&& (bShouldBeLoaded == true || Streaming->GetShouldBeVisibleFlag() == false))
+		{
+			Streaming->SetShouldBeLoaded(bShouldBeLoaded);
+		}
+
+		const bool bShouldBeVisible = Zone.Target == EZoneTarget::Visible;
+		if (Streaming->GetShouldBeVisibleFlag() != bShouldBeVisible)
+		{
+			if (bShouldBeVisible == false)
+			{
+				ZoneToHide = ZoneToHide == INDEX_NONE ? Index : ZoneToHide;
+			}
+			// The zone the player is in goes first, then whichever is closest to their path.
+			else if (ZoneToShow == INDEX_NONE || Index == CurrentZone || (ZoneToShow != CurrentZone
+				&& Zone.PathDistanceSquared < Zones[ZoneToShow].PathDistanceSquared))
+			{
+				ZoneToShow = Index;
+			}
+		}
+
+		if (State == ELevelStreamingState::LoadedVisible)
+		{
+			if (Zone.bReportedActive == false)
+			{
+				Zone.bReportedActive = true;
+				OnZoneActivated.Broadcast(Zone.Name);
+			}
+		}
+		else
+		{
+			Zone.bReportedActive = false;
+		}
+	}
+
+	// Adding or removing the actors of a zone is spread over frames under the streaming time budget;
+	// changing one zone at a time keeps two of them from sharing, and overrunning, the same frames.
+	// The zone the player is in goes first, then the closest one ahead, and hiding the ones left behind last.
+	if (bVisibilityChanging == true)
+	{
+		return;
+	}
+
+	if (ZoneToShow != INDEX_NONE)
+	{
+		Zones[ZoneToShow].Streaming->SetShouldBeVisible(true);
+	}
+	else if (ZoneToHide != INDEX_NONE)
+	{
+		Zones[ZoneToHide].Streaming->SetShouldBeVisible(false);
+	}
+}
+
+TStatId UC_WS_ZoneStreaming::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UC_WS_ZoneStreaming, STATGROUP_Tickables);
+}
+
+void UC_WS_ZoneStreaming::Deinitialize()
+{
+	Zones.Empty();
+	ZoneIndexByName.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UC_WS_ZoneStreaming::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
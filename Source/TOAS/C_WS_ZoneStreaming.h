@@ -0,0 +1,162 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "C_WS_ZoneStreaming.generated.h"
+
+class UDataTable;
+class ULevelStreaming;
+
+// Delegation of a zone becoming visible and active.
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FZoneActivated, FName, Zone);
+
+// Delegation of the player entering another zone.
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FZoneEntered, FName, PreviousZone, FName, Zone);
+
+/**
+ * World Subsystem that streams the zones of the persistent level ahead of the player.
+ * Knowing the zone graph, it predicts where the player is heading from their position and velocity,
+ * loads the packages of the zones ahead while they are still hidden, and shows them before they are reached.
+ * Visibility changes go one zone at a time, each spread over frames under the streaming time budget
+ * (s.LevelStreamingActorsUpdateTimeLimit, set in DefaultEngine.ini so command lines and device profiles can override it).
+ */
+UCLASS(config=Game)
+class TOAS_API UC_WS_ZoneStreaming : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Sets the zone graph streamed from now on, replacing the previous one.
+	 * @param ZoneTable Data Table of FZoneRow; each row name is the name of a zone.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zone_Streaming")
+	void SetZoneGraph(const UDataTable* ZoneTable);
+
+	/**
+	 * Requests a zone to be loaded and shown regardless of the prediction, like when a zone changer is reached
+	 * or the player is about to be teleported. It stays requested until the player enters it.
+	 * @param Zone Name of the zone to request.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zone_Streaming")
+	void RequestZone(const FName Zone);
+
+	/**
+	 * Getter of the progress of a zone towards being visible and active.
+	 * Loading fills most of it, and becoming visible the rest.
+	 * @return 0 if the zone isn't loaded or is unknown, 1 once it's visible.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zone_Streaming")
+	float GetZoneProgress(const FName Zone) const;
+
+	// Checks whether a zone is visible and active.
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zone_Streaming")
+	bool IsZoneActive(const FName Zone) const { return GetZoneProgress(Zone) >= 1.0f; }
+
+	// Getter of the zone the player is in; None if outside of every zone.
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zone_Streaming")
+	FName GetCurrentZone() const;
+
+	// Delegate for calling out to when a zone becomes visible and active.
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FZoneActivated OnZoneActivated;
+
+	// Delegate for calling out to when the player enters another zone.
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FZoneEntered OnZoneEntered;
+
+	// Predicts the zones needed every PredictionInterval seconds, and applies their streaming every frame.
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+protected:
+	// Streaming only matters in game worlds.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Seconds between predictions.
+	UPROPERTY(Config)
+	float PredictionInterval = 0.2f;
+
+	// Seconds ahead the player's position is predicted, following their velocity.
+	UPROPERTY(Config)
+	float LookAheadTime = 3.0f;
+
+	// Neighbouring zones closer than this to the predicted position are loaded, still hidden.
+	UPROPERTY(Config)
+	float PrefetchDistance = 3000.0f;
+
+	// Neighbouring zones closer than this to the predicted position are also shown, so they are ready when reached.
+	UPROPERTY(Config)
+	float ActivationDistance = 800.0f;
+
+	// Zones farther than this from the player are unloaded once nothing needs them.
+	// Kept above PrefetchDistance, so zones on the border aren't loaded and unloaded over and over.
+	UPROPERTY(Config)
+	float UnloadDistance = 5000.0f;
+
+private:
+	// How far a zone should be streamed.
+	enum class EZoneTarget : uint8
+	{
+		Unloaded,
+		Loaded,
+		Visible
+	};
+
+	struct FZone
+	{
+		FName Name;
+		FName PackageName;
+		FBox Bounds = FBox(ForceInit);
+
+		// Indices of the neighbouring zones.
+		TArray<int32> Neighbours;
+
+		// Streaming level of the zone, found on first use.
+		TWeakObjectPtr<ULevelStreaming> Streaming;
+
+		EZoneTarget Target = EZoneTarget::Unloaded;
+
+		// Squared distance from the zone to the player's predicted path, as of the last prediction.
+		float PathDistanceSquared = 0.0f;
+
+		// Whether OnZoneActivated was already called for the current visibility.
+		bool bReportedActive = false;
+
+		// Whether RequestZone asked for the zone.
+		bool bRequested = false;
+	};
+
+	// Finds the streaming level of a zone, caching it.
+	ULevelStreaming* GetStreaming(FZone& Zone) const;
+
+	// Finds the zone containing a point, preferring the current one; INDEX_NONE if none does.
+	int32 FindZoneAt(const FVector& Point) const;
+
+	// Decides the target of every zone from the position and velocity of the player.
+	void Predict();
+
+	// Issues the loads and unloads needed by the targets, and at most one visibility change.
+	void ApplyTargets();
+
+	// Every zone of the graph.
+	TArray<FZone> Zones;
+
+	// Index of each zone by name.
+	TMap<FName, int32> ZoneIndexByName;
+
+	// Zone the player is in.
+	int32 CurrentZone = INDEX_NONE;
+
+	// Time accumulated since the last prediction.
+	float TimeSincePrediction = 0.0f;
+};
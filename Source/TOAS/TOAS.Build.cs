@@ -14,6 +14,6 @@ public class TOAS : ModuleRules
 				"Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "AIModule", "Slate", "SlateCore"
 			});
 		
-		// PrivateDependencyModuleNames.AddRange(new string[] {});
+		PrivateDependencyModuleNames.AddRange(new string[] { "Json" });
 	}
 }
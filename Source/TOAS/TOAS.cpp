@@ -1,7 +1,71 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TOAS.h"
+#include "Misc/CoreDelegates.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, TOAS, "TOAS" );
- 
\ No newline at end of file
+UE_TRACE_CHANNEL_DEFINE(TOASChannel);
+CSV_DEFINE_CATEGORY_MODULE(TOAS_API, TOAS, true);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attack Traces"), STAT_TOAS_AttackTraces, STATGROUP_TOAS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Perception Traces"), STAT_TOAS_PerceptionTraces, STATGROUP_TOAS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Z-Target Queries"), STAT_TOAS_ZTargetQueries, STATGROUP_TOAS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Hits Resolved"), STAT_TOAS_HitsResolved, STATGROUP_TOAS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Damage Events"), STAT_TOAS_DamageEvents, STATGROUP_TOAS);
+
+// Game module that publishes the combat counters at the end of every frame.
+class FTOASModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&TOASCounters::EndFrame);
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	}
+
+private:
+	FDelegateHandle EndFrameHandle;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FTOASModule, TOAS, "TOAS" );
+
+namespace TOASCounters
+{
+	std::atomic<int32> AttackTraces = 0;
+	std::atomic<int32> PerceptionTraces = 0;
+	std::atomic<int32> ZTargetQueries = 0;
+	std::atomic<int32> HitsResolved = 0;
+	std::atomic<int32> DamageEvents = 0;
+
+	static FFrameCounts LastFrame;
+
+	const FFrameCounts& GetLastFrame()
+	{
+		return LastFrame;
+	}
+
+	void EndFrame()
+	{
+		LastFrame.AttackTraces = AttackTraces.exchange(0);
+		LastFrame.PerceptionTraces = PerceptionTraces.exchange(0);
+		LastFrame.ZTargetQueries = ZTargetQueries.exchange(0);
+		LastFrame.HitsResolved = HitsResolved.exchange(0);
+		LastFrame.DamageEvents = DamageEvents.exchange(0);
+
+		SET_DWORD_STAT(STAT_TOAS_AttackTraces, LastFrame.AttackTraces);
+		SET_DWORD_STAT(STAT_TOAS_PerceptionTraces, LastFrame.PerceptionTraces);
+		SET_DWORD_STAT(STAT_TOAS_ZTargetQueries, LastFrame.ZTargetQueries);
+		SET_DWORD_STAT(STAT_TOAS_HitsResolved, LastFrame.HitsResolved);
+		SET_DWORD_STAT(STAT_TOAS_DamageEvents, LastFrame.DamageEvents);
+
+		CSV_CUSTOM_STAT(TOAS, AttackTraces, LastFrame.AttackTraces, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TOAS, PerceptionTraces, LastFrame.PerceptionTraces, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TOAS, ZTargetQueries, LastFrame.ZTargetQueries, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TOAS, HitsResolved, LastFrame.HitsResolved, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TOAS, DamageEvents, LastFrame.DamageEvents, ECsvCustomStatOp::Set);
+	}
+}
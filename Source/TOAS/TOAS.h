@@ -3,3 +3,55 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+#include <atomic>
+
+// Stats shown with "stat TOAS", and the Insights channel enabled with "-trace=cpu,TOAS".
+DECLARE_STATS_GROUP(TEXT("TOAS"), STATGROUP_TOAS, STATCAT_Advanced);
+UE_TRACE_CHANNEL_EXTERN(TOASChannel, TOAS_API);
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(TOAS_API, TOAS);
+
+// Times the enclosing scope in "stat TOAS" and shows it by name in Insights.
+// The cycle stat STAT_TOAS_<Name> must be declared in the same file with DECLARE_CYCLE_STAT.
+#define TOAS_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_TOAS_##Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("TOAS::" #Name, TOASChannel)
+
+// Counters of the combat hot paths, increased as they happen.
+// Once per frame, EndFrame publishes them to "stat TOAS" and the CSV profiler, keeps them as the last frame's counts
+// and resets them.
+namespace TOASCounters
+{
+	// Attack sweeps performed, synchronous or through the Combat Query Scheduler.
+	extern TOAS_API std::atomic<int32> AttackTraces;
+
+	// Traces done by enemies looking for the player, on their own or through the Enemy Perception subsystem.
+	extern TOAS_API std::atomic<int32> PerceptionTraces;
+
+	// Searches for a Z-Target done by playable characters.
+	extern TOAS_API std::atomic<int32> ZTargetQueries;
+
+	// Characters reached by an attack's hits.
+	extern TOAS_API std::atomic<int32> HitsResolved;
+
+	// Damage actually applied to characters.
+	extern TOAS_API std::atomic<int32> DamageEvents;
+
+	// Counts of a whole frame.
+	struct FFrameCounts
+	{
+		int32 AttackTraces = 0;
+		int32 PerceptionTraces = 0;
+		int32 ZTargetQueries = 0;
+		int32 HitsResolved = 0;
+		int32 DamageEvents = 0;
+	};
+
+	// Returns the counts of the last frame that ended.
+	TOAS_API const FFrameCounts& GetLastFrame();
+
+	// Publishes and resets the counters; bound to the end of every frame by the module.
+	void EndFrame();
+}
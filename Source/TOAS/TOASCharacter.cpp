@@ -4,15 +4,26 @@
 // While others may use the provided code and content for their own projects, proper credit is required and appreciated.
 
 #include "TOASCharacter.h"
+#include "TOAS.h"
 #include "C_StructsAndEnums.h"
 #include "C_AComp_Stats.h"
+#include "C_AComp_SocketCache.h"
+#include "C_WS_DamageQueue.h"
+#include "C_WS_TargetRegistry.h"
 #include "Engine/LocalPlayer.h"
 #include "Components/CapsuleComponent.h"
-#include "Components/WidgetComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Controller.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "KismetTraceUtils.h"
+
+// TraceAttack and TraceAttackMulti only compile the properties and call TraceAttackDescriptor,
+// so they are measured there alone instead of being counted twice.
+DECLARE_CYCLE_STAT(TEXT("Trace Attack Descriptor"), STAT_TOAS_TraceAttackDescriptor, STATGROUP_TOAS);
+DECLARE_CYCLE_STAT(TEXT("Resolve Attack Hits"), STAT_TOAS_ResolveAttackHits, STATGROUP_TOAS);
+DECLARE_CYCLE_STAT(TEXT("Resolve Damage"), STAT_TOAS_ResolveDamage, STATGROUP_TOAS);
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
@@ -44,16 +55,8 @@ ATOASCharacter::ATOASCharacter()
 
 	// Create the Actor Component to track stats and levels.
 	StatsComponent = CreateDefaultSubobject<UC_AComp_Stats>("Character_Statics");
-	// Creates and sets the Widget Component to display the target system.
-	TargetWidgetComponent = CreateDefaultSubobject<UWidgetComponent>("Target_WidgetComponent");
-	TargetWidgetComponent->AttachToComponent(GetRootComponent(),
-		FAttachmentTransformRules::KeepRelativeTransform);
-	TargetWidgetComponent->SetDrawSize(FVector2D::One() * 50.0f);
-
-	SeenWidgetComponent = CreateDefaultSubobject<UWidgetComponent>("Seen_WidgetComponent");
-	SeenWidgetComponent->AttachToComponent(GetRootComponent(),
-		FAttachmentTransformRules::KeepRelativeTransform);
-	SeenWidgetComponent->SetDrawSize(FVector2D::One() * 50.0f);
+	// Create the Actor Component that caches the world transforms of sockets once per frame.
+	SocketCacheComponent = CreateDefaultSubobject<UC_AComp_SocketCache>("Character_SocketCache");
 
 	bCanHurt = true;
 }
@@ -118,67 +121,64 @@ void ATOASCharacter::CheckIfFloatIsInBetweenValues(const float& Distance, const
 	IsInBetween = (Distance >= Min && Distance <= Max);
 }
 
-void ATOASCharacter::TraceAttack(const FVector StartLocation, const FVector EndLocation, const FAttackProperties AttackProperties)
+void ATOASCharacter::TraceAttack(const FVector StartLocation, const FVector EndLocation,
+	const FAttackProperties& AttackProperties)
 {
-	// This array is created here to make Tracing work, despite not having anything here.
-	TArray<AActor*> ActorsToIgnore = {};
+	// Blueprint calls compile the properties on the spot; notifies compile them once per swing instead.
+	TraceAttackDescriptor(StartLocation, EndLocation, FAttackDescriptor::Compile(AttackProperties), false);
+}
 
-	// Used to store the FHitResult that is returned from the Tracing.
-	FHitResult HitResults;
+void ATOASCharacter::TraceAttackMulti(const FVector StartLocation, const FVector EndLocation,
+	const FAttackProperties& AttackProperties)
+{
+	// Blueprint calls compile the properties on the spot; notifies compile them once per swing instead.
+	TraceAttackDescriptor(StartLocation, EndLocation, FAttackDescriptor::Compile(AttackProperties), true);
+}
 
-	// Performs the Trace using FVectors received from the Anim Notify or Anim Notify State
-	bool HIT = UKismetSystemLibrary::SphereTraceSingleForObjects(this, StartLocation, EndLocation,
-		AttackProperties.RadiusOfAttack, AttackProperties.HitObjectTypes, false, ActorsToIgnore,
-		DebugTraceEnum, HitResults, true, FLinearColor::Red,
-		FLinearColor::Green, 0.25f);
+void ATOASCharacter::TraceAttackDescriptor(const FVector& StartLocation, const FVector& EndLocation,
+	const FAttackDescriptor& Attack, const bool bMultiHit, FAttackHitRegistry* HitRegistry)
+{
+	TOAS_SCOPE(TraceAttackDescriptor);
 
-	if (HIT == false)
-	{
-		// If no hit was detected, stop function execution.
-		return;
-	}
+	// Same settings the Kismet trace used: simple collision and ignoring this character.
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TOASAttackSweep), false, this);
+	++TOASCounters::AttackTraces;
 
-	if (ATOASCharacter* CastedChar = Cast<ATOASCharacter>(HitResults.GetActor()))
+	if (bMultiHit == false)
 	{
-		if (CastedChar->bIsEnemy != bIsEnemy)
-		{
-			// Get the Attack stat from this character's Stats Component
-			// as well as the Attack Properties coming from the animation.
-			CastedChar->GettingDamaged(GetStats()->GetATK(), AttackProperties.AttackMultiplier, GetActorLocation(),
-				AttackProperties.AttackForwardImpulse, AttackProperties.AttackUpImpulse,
-				EElementalAttribute::NEUTRAL);
-			// Stop function execution when an attack landed on a Character, be it player or enemy.
-			// Hits should prioritize Characters.
-
-			if (CastedChar == ZTargetToTrack)
-			{
-				if (CastedChar->GetStats()->GetCurrentHP() <= 0)
-				{
-					ZTargetToTrack = nullptr;
-				}
-			}
+		// Used to store the FHitResult that is returned from the Tracing.
+		FHitResult HitResult;
 
-			OnAttackHasLanded.Broadcast();
+		// Performs the Trace using FVectors received from the Anim Notify or Anim Notify State
+		const bool HIT = GetWorld()->SweepSingleByObjectType(HitResult, StartLocation, EndLocation, FQuat::Identity,
+			Attack.ObjectQueryParams, Attack.CollisionShape, QueryParams);
+
+#if ENABLE_DRAW_DEBUG
+		DrawDebugSphereTraceSingle(GetWorld(), StartLocation, EndLocation, Attack.CollisionShape.GetSphereRadius(),
+			DebugTraceEnum, HIT, HitResult, FLinearColor::Red, FLinearColor::Green, 0.25f);
+#endif
+
+		if (HIT == false)
+		{
+			// If no hit was detected, stop function execution.
+			return;
 		}
+
+		ResolveAttackHits(MakeArrayView(&HitResult, 1), Attack, false, HitRegistry);
 		return;
 	}
 
-	// Section reserved for Interactable Objects on Hit.
-}
-
-void ATOASCharacter::TraceAttackMulti(const FVector StartLocation, const FVector EndLocation,
-	const FAttackProperties AttackProperties)
-{
-	// This array is created here to make Tracing work, despite not having anything here.
-	TArray<AActor*> ActorsToIgnore = {};
-
-	// Used to store the FHitResult that is returned from the Tracing.
+	// Used to store the FHitResults that are returned from the Tracing.
 	TArray<FHitResult> HitResults;
 
 	// Performs the Trace using FVectors received from the Anim Notify or Anim Notify State
-	bool HIT = UKismetSystemLibrary::SphereTraceMultiForObjects(this, StartLocation, EndLocation,
-		AttackProperties.RadiusOfAttack, AttackProperties.HitObjectTypes, false, ActorsToIgnore,
-		DebugTraceEnum, HitResults, true);
+	const bool HIT = GetWorld()->SweepMultiByObjectType(HitResults, StartLocation, EndLocation, FQuat::Identity,
+		Attack.ObjectQueryParams, Attack.CollisionShape, QueryParams);
+
+#if ENABLE_DRAW_DEBUG
+	DrawDebugSphereTraceMulti(GetWorld(), StartLocation, EndLocation, Attack.CollisionShape.GetSphereRadius(),
+		DebugTraceEnum, HIT, HitResults, FLinearColor::Red, FLinearColor::Green, 5.0f);
+#endif
 
 	if (HIT == false)
 	{
@@ -186,31 +186,66 @@ void ATOASCharacter::TraceAttackMulti(const FVector StartLocation, const FVector
 		return;
 	}
 
-	for (FHitResult HitResult : HitResults)
+	ResolveAttackHits(HitResults, Attack, true, HitRegistry);
+}
+
+void ATOASCharacter::ResolveAttackHits(TConstArrayView<FHitResult> HitResults, const FAttackDescriptor& Attack,
+	const bool bMultiHit, FAttackHitRegistry* HitRegistry)
+{
+	TOAS_SCOPE(ResolveAttackHits);
+
+	for (const FHitResult& HitResult : HitResults)
 	{
-		if (ATOASCharacter* CastedChar = Cast<ATOASCharacter>(HitResult.GetActor()))
+		// Only opposing characters take damage; geometry and allies are skipped.
+		// Reserved for interactable objects on Hit.
+		ATOASCharacter* CastedChar = Cast<ATOASCharacter>(HitResult.GetActor());
+		if (CastedChar == nullptr || CastedChar->bIsEnemy == bIsEnemy)
+		{
+			continue;
+		}
+
+		// Characters still recovering from another hit are neither damaged nor registered, so later sweeps
+		// of the swing can still reach them or whatever lies behind them.
+		// Single hit attacks still stop at them and report landing, as they did before damage was queued.
+		if (CastedChar->bCanHurt == false)
 		{
-			if (CastedChar->bIsEnemy != bIsEnemy)
+			if (bMultiHit == false)
 			{
-				// Get the Attack stat from this character's Stats Component
-				// as well as the Attack Properties coming from the animation.
-				CastedChar->GettingDamaged(GetStats()->GetATK(), AttackProperties.AttackMultiplier, GetActorLocation(),
-					AttackProperties.AttackForwardImpulse, AttackProperties.AttackUpImpulse,
-					EElementalAttribute::NEUTRAL);
-				// Stop function execution when an attack landed on a Character, be it player or enemy.
-				// Hits should prioritize Characters.
-
-				if (CastedChar == ZTargetToTrack)
-				{
-					if (CastedChar->GetStats()->GetCurrentHP() <= 0)
-					{
-						ZTargetToTrack = nullptr;
-					}
-				}
+				OnAttackHasLanded.Broadcast();
+				return;
 			}
+			continue;
 		}
 
-		// Reserved for interactable objects on Hit.
+		// Victims already damaged during this swing are skipped before any damage work.
+		if (HitRegistry != nullptr)
+		{
+			if (HitRegistry->WasHit(CastedChar) == true)
+			{
+				continue;
+			}
+			HitRegistry->RegisterHit(CastedChar);
+		}
+
+		++TOASCounters::HitsResolved;
+		// Get the Attack stat from this character's Stats Component
+		// as well as the Attack Properties coming from the animation.
+		FDamageRecord Damage;
+		Damage.Instigator = this;
+		Damage.InstigatorLocation = GetActorLocation();
+		Damage.Multiplier = Attack.AttackMultiplier;
+		Damage.FwdImpulse = Attack.AttackForwardImpulse;
+		Damage.UpImpulse = Attack.AttackUpImpulse;
+		Damage.InstigatorATK = GetStats()->GetATK();
+		Damage.Element = Attack.Element;
+		CastedChar->QueueDamage(Damage);
+
+		// Single hit attacks stop at the first Character they land on, and only they report it.
+		if (bMultiHit == false)
+		{
+			OnAttackHasLanded.Broadcast();
+			return;
+		}
 	}
 }
 
@@ -218,10 +253,38 @@ void ATOASCharacter::GettingDamaged(const uint8 &InstigatorATK, const float &fMu
                                     const FVector &InstigatorLocation, float FwdImpulse, float UpImpulse,
                                     const EElementalAttribute& ElementalAttribute = EElementalAttribute::NEUTRAL)
 {	
+	FDamageRecord Damage;
+	Damage.InstigatorLocation = InstigatorLocation;
+	Damage.Multiplier = fMultiplier;
+	Damage.FwdImpulse = FwdImpulse;
+	Damage.UpImpulse = UpImpulse;
+	Damage.InstigatorATK = InstigatorATK;
+	Damage.Element = ElementalAttribute;
+	QueueDamage(Damage);
+}
+
+void ATOASCharacter::QueueDamage(FDamageRecord Damage)
+{
+	Damage.Victim = this;
+	Damage.VictimId = GetUniqueID();
+
+	if (UC_WS_DamageQueue* DamageQueue = GetWorld()->GetSubsystem<UC_WS_DamageQueue>())
+	{
+		DamageQueue->QueueDamage(Damage);
+		return;
+	}
+
+	ResolveDamage(Damage);
+}
+
+void ATOASCharacter::ResolveDamage(const FDamageRecord& Damage, TConstArrayView<FDamageRecord> MergedHits)
+{
+	TOAS_SCOPE(ResolveDamage);
+
 	if (bCanHurt == true)
 	{
 		FRotator RotAtAttacker;
-		GetLookAtRotatorWithLocation(InstigatorLocation, RotAtAttacker);
+		GetLookAtRotatorWithLocation(Damage.InstigatorLocation, RotAtAttacker);
 		SetActorRotation(RotAtAttacker);
 
 		bCanHurt = false;
@@ -232,7 +295,11 @@ void ATOASCharacter::GettingDamaged(const uint8 &InstigatorATK, const float &fMu
 			return;
 		}
 		
-		GetStats()->GetPhysicalDamage(InstigatorATK, fMultiplier, ElementalAttribute);
+		GetStats()->GetPhysicalDamage(Damage.InstigatorATK, Damage.Multiplier, Damage.Element);
+		++TOASCounters::DamageEvents;
+
+		float FwdImpulse = Damage.FwdImpulse;
+		float UpImpulse = Damage.UpImpulse;
 		
 		if (GetStats()->GetCurrentHP() <= 0)
 		{
@@ -252,66 +319,77 @@ void ATOASCharacter::GettingDamaged(const uint8 &InstigatorATK, const float &fMu
 		GetCharacterMovement()->StopMovementImmediately();
 		LaunchCharacter(LaunchVector, true, true);
 
-		FwdImpulse = UKismetMathLibrary::Abs(FwdImpulse);
-
-		UpImpulse = UKismetMathLibrary::Abs(UpImpulse);
-
-		const float MaxImpulse = UKismetMathLibrary::FMax(FwdImpulse, UpImpulse);
+		const float MaxImpulse = FMath::Max(FMath::Abs(FwdImpulse), FMath::Abs(UpImpulse));
 		OnGetDamagedEvent.Broadcast(MaxImpulse);
 	}
-}
 
-void ATOASCharacter::IsSeen()
-{
-	if (SeenWidgetComponent == nullptr)
+	// Defeated characters stop being the Z-Target of whoever defeated them, including the instigators of merged hits.
+	if (GetStats() == nullptr || GetStats()->GetCurrentHP() > 0)
 	{
 		return;
 	}
 
-	if (GetStats()->GetCurrentHP() <= 0)
+	auto ReleaseZTarget = [this](ATOASCharacter* DamageInstigator)
 	{
-		SeenWidgetComponent->SetVisibility(false);
-		TargetWidgetComponent->SetVisibility(false);
-		return;
-	}
+		if (IsValid(DamageInstigator) == true && DamageInstigator->ZTargetToTrack == this)
+		{
+			IsUnseen();
+			DamageInstigator->ZTargetToTrack = nullptr;
+		}
+	};
 
-	if (SeenWidgetComponent->IsVisible() == true)
+	ReleaseZTarget(Damage.Instigator.Get());
+	for (const FDamageRecord& Hit : MergedHits)
 	{
-		return;
+		ReleaseZTarget(Hit.Instigator.Get());
 	}
+}
 
-	SeenWidgetComponent->SetVisibility(true);
-	TargetWidgetComponent->SetVisibility(false);
+void ATOASCharacter::IsSeen()
+{
+	// Defeated characters are never marked.
+	TargetMark = GetStats()->GetCurrentHP() > 0 ? ETargetMark::SEEN : ETargetMark::NONE;
 }
 
 void ATOASCharacter::IsUnseen()
 {
-	if (SeenWidgetComponent == nullptr)
-	{
-		return;
-	}
-
-	SeenWidgetComponent->SetVisibility(false);
-	TargetWidgetComponent->SetVisibility(false);
+	TargetMark = ETargetMark::NONE;
 }
 
 void ATOASCharacter::IsTargeted()
 {
-	if (TargetWidgetComponent == nullptr)
-	{
-		return;
-	}
+	TargetMark = ETargetMark::TARGETED;
+}
+
+void ATOASCharacter::ApplySignificanceTier(const FSignificanceTier& Tier)
+{
+	SetActorTickInterval(Tier.ActorTickInterval);
+	GetCharacterMovement()->SetComponentTickInterval(Tier.MovementTickInterval);
 
-	if (TargetWidgetComponent->IsVisible() == true)
+	if (USkeletalMeshComponent* MeshComponent = GetMesh())
 	{
-		return;
+		MeshComponent->bEnableUpdateRateOptimizations = Tier.bUseUpdateRateOptimizations;
+		MeshComponent->VisibilityBasedAnimTickOption = Tier.AnimTickOption;
 	}
-
-	SeenWidgetComponent->SetVisibility(false);
-	TargetWidgetComponent->SetVisibility(true);
 }
 
 void ATOASCharacter::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Every character can be seen and targeted by the Z-Targeting System.
+	if (UC_WS_TargetRegistry* TargetRegistry = GetWorld()->GetSubsystem<UC_WS_TargetRegistry>())
+	{
+		TargetRegistry->RegisterTargetable(this);
+	}
+}
+
+void ATOASCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UC_WS_TargetRegistry* TargetRegistry = GetWorld()->GetSubsystem<UC_WS_TargetRegistry>())
+	{
+		TargetRegistry->UnregisterTargetable(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "C_StructsAndEnums.h"
 #include "GameFramework/Character.h"
 #include "Logging/LogMacros.h"
 #include "Delegates/Delegate.h"
@@ -15,10 +16,12 @@
 // Forward Declaration of following classes to be used:
 // Stats Component.
 class UC_AComp_Stats;
+// Socket Cache Component.
+class UC_AComp_SocketCache;
 // Animation Montages to use.
 class UAnimMontage;
-// Widget Components for Z-Targeting System.
-class UWidgetComponent;
+// Hits waiting in the Damage Queue.
+struct FDamageRecord;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
 
@@ -38,6 +41,9 @@ public:
 	// Returns the Stats Component for public access.
 	FORCEINLINE UC_AComp_Stats* GetStats() const { return StatsComponent; }
 
+	// Returns the Socket Cache Component for public access.
+	FORCEINLINE UC_AComp_SocketCache* GetSocketCache() const { return SocketCacheComponent; }
+
 	// Delegate for calling out to Damage Montages (using the preferable Blueprint Node with more control). 
 	UPROPERTY(BlueprintAssignable, BlueprintCallable)
 	FGetDamagedEvent OnGetDamagedEvent;
@@ -52,11 +58,15 @@ protected:
 		meta = (AllowPrivateAccess = "true"))
 	UC_AComp_Stats* StatsComponent;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Character_Components")
-	UWidgetComponent* TargetWidgetComponent;
+	// Reference to the Socket Cache Component, shared by traces, perception and footsteps.
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Character_Components",
+		meta = (AllowPrivateAccess = "true"))
+	UC_AComp_SocketCache* SocketCacheComponent;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Character_Components")
-	UWidgetComponent* SeenWidgetComponent;
+	// How the Z-Targeting System is marking this character; the Lock-On Presenter draws the matching indicator.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character_ControlValues",
+		meta = (AllowPrivateAccess = "true"))
+	ETargetMark TargetMark = ETargetMark::NONE;
 
 	// Actor to target and lock view onto.
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "PC_ControlValues", meta = (AllowPrivateAccess = "true"))
@@ -131,20 +141,52 @@ public:
 	// Function that uses Sphere Traces for Objects to track Hits from Attacks.
 	// Can hurt opposing characters or even hit triggers like switches and other interactive Dynamic Actors in the world 
 	UFUNCTION(BlueprintCallable, Category="CharacterFunctions")
-	void TraceAttack(const FVector StartLocation, const FVector EndLocation, const FAttackProperties AttackProperties);
+	void TraceAttack(const FVector StartLocation, const FVector EndLocation, const FAttackProperties& AttackProperties);
 
 	// Function that uses Sphere Traces for Objects to track Hits from Attacks.
 	// Can hurt opposing characters or even hit triggers like switches and other interactive Dynamic Actors in the world 
 	UFUNCTION(BlueprintCallable, Category="CharacterFunctions")
-	void TraceAttackMulti(const FVector StartLocation, const FVector EndLocation, const FAttackProperties AttackProperties);
+	void TraceAttackMulti(const FVector StartLocation, const FVector EndLocation, const FAttackProperties& AttackProperties);
+
+	/**
+	 * Native version of the Attack Traces, using an already compiled attack so nothing gets copied or allocated.
+	 * @param StartLocation World Location where the sweep begins.
+	 * @param EndLocation World Location where the sweep ends.
+	 * @param Attack Compiled attack to trace.
+	 * @param bMultiHit If true, every hit along the sweep is resolved instead of only the first one.
+	 * @param HitRegistry Optional registry of the swing; actors already in it are skipped.
+	 */
+	void TraceAttackDescriptor(const FVector& StartLocation, const FVector& EndLocation, const FAttackDescriptor& Attack,
+		const bool bMultiHit, FAttackHitRegistry* HitRegistry = nullptr);
+
+	/**
+	 * Resolves the hits obtained from an attack's trace, queuing damage on opposing characters.
+	 * Shared by the synchronous traces above and the Combat Query Scheduler once its async sweeps are done.
+	 * @param HitResults Hits returned by the trace, in the order given by the physics query.
+	 * @param Attack Compiled attack that produced the hits.
+	 * @param bMultiHit If false, only the first hit is resolved and landing the attack is broadcast.
+	 * @param HitRegistry Optional registry of the swing; actors already in it are skipped before any damage work.
+	 */
+	void ResolveAttackHits(TConstArrayView<FHitResult> HitResults, const FAttackDescriptor& Attack,
+		const bool bMultiHit, FAttackHitRegistry* HitRegistry = nullptr);
 
 	// Called when receiving damage from attacks or even hazards.
-	// Works out the damage based on specific calculations, like elemental damage or Power Multiplier per Hit
-	// (Multiplier obtained from each hit in an Animation).
+	// The hit goes through the Damage Queue, which works out the damage based on specific calculations, like elemental
+	// damage or Power Multiplier per Hit (Multiplier obtained from each hit in an Animation).
+	// In game worlds the damage is applied on the queue's next Tick, so Hit Points read right after this are still the old ones.
 	UFUNCTION(BlueprintCallable, Category="CharacterFunctions")
 	void GettingDamaged(const uint8 &InstigatorATK, const float &fMultiplier, const FVector &InstigatorLocation,
 		float FwdImpulse, float UpImpulse, const EElementalAttribute& ElementalAttribute);
 
+	// Sends a hit on this character to the Damage Queue, or applies it right away in worlds without one.
+	// The victim of the record is always set to this character.
+	void QueueDamage(FDamageRecord Damage);
+
+	// Applies a hit once the Damage Queue has merged it with the rest landed on this character during the frame:
+	// faces the instigator, takes the damage, gets launched and broadcasts the reaction.
+	// MergedHits are every hit merged together; if this character is defeated, none of their instigators keeps it as Z-Target.
+	void ResolveDamage(const FDamageRecord& Damage, TConstArrayView<FDamageRecord> MergedHits = {});
+
 	UFUNCTION(BlueprintCallable, Category="CharacterFunctions")
 	void IsSeen();
 
@@ -154,11 +196,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category="CharacterFunctions")
 	void IsTargeted();
 
+	// Returns how the Z-Targeting System is currently marking this character.
+	FORCEINLINE ETargetMark GetTargetMark() const { return TargetMark; }
+
+	// Checks if the Z-Targeting System is currently showing this character as seen or targeted.
+	FORCEINLINE bool IsMarkedForTargeting() const { return TargetMark != ETargetMark::NONE; }
+
+	// Applies the update settings of a Significance Tier to the Actor, its movement and mesh.
+	void ApplySignificanceTier(const FSignificanceTier& Tier);
+
 protected:
 
 	// Call begin play when spawning in the world.
 	virtual void BeginPlay() override;
 
+	// Leaves the Target Registry when removed from the world.
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// Obtains the distance from the Character to a set Location, for example, another Actor or even Character.
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Calculators")
 	void GetCharacterDistanceToLocation(const FVector TargetLocation, float &OutDistanceFloat);
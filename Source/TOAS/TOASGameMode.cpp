@@ -5,22 +5,39 @@
 
 #include "TOASGameMode.h"
 
+#include "C_CombatBenchmark.h"
 #include "C_WB_MainMenu.h"
 #include "C_WidgetNavigationSystem.h"
 #include "Blueprint/UserWidget.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
 #include "UObject/ConstructorHelpers.h"
 
 ATOASGameMode::ATOASGameMode()
 {
-	
+	CombatBenchmarkClass = AC_CombatBenchmark::StaticClass();
 }
 
 void ATOASGameMode::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Performance captures skip the menus: the benchmark takes over the level and quits once done.
+	if (FParse::Param(FCommandLine::Get(), TEXT("CombatBenchmark")) && CombatBenchmarkClass != nullptr)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.bDeferConstruction = true;
+		if (AC_CombatBenchmark* Benchmark = GetWorld()->SpawnActor<AC_CombatBenchmark>(CombatBenchmarkClass,
+			FTransform::Identity, SpawnParameters))
+		{
+			Benchmark->SetQuitWhenDone(true);
+			Benchmark->FinishSpawning(FTransform::Identity);
+		}
+		return;
+	}
+
 	if (MainMenuWidgetClass == nullptr)
 	{
 		return;
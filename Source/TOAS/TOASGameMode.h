@@ -11,6 +11,7 @@
 
 class UC_WB_MainMenu;
 class AC_SaveManager;
+class AC_CombatBenchmark;
 
 UCLASS(minimalapi)
 class ATOASGameMode : public AGameModeBase
@@ -29,6 +30,10 @@ protected:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=UI, meta=(AllowPrivateAccess="true"))
 	TSubclassOf<UUserWidget> MainMenuWidgetClass;
+
+	// Benchmark spawned when the game is launched with -CombatBenchmark.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Benchmark, meta=(AllowPrivateAccess="true"))
+	TSubclassOf<AC_CombatBenchmark> CombatBenchmarkClass;
 };
 
 
@@ -0,0 +1,69 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_WS_DamageQueue.h"
+#include "C_AComp_Stats.h"
+#include "C_StructsAndEnums.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DamageQueueTests
+{
+	FDamageRecord MakeHit(const uint8 InstigatorATK, const float Multiplier, const EElementalAttribute Element)
+	{
+		FDamageRecord Hit;
+		Hit.InstigatorATK = InstigatorATK;
+		Hit.Multiplier = Multiplier;
+		Hit.Element = Element;
+		return Hit;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDamageQueueMergeTest, "TOAS.DamageQueue.MergesIntoStrongestHit",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDamageQueueMergeTest::RunTest(const FString& Parameters)
+{
+	using DamageQueueTests::MakeHit;
+
+	// A victim with 10 DEF that resists half of the fire damage.
+	FSavedStats Block;
+	Block.Level = 1;
+	Block.MaxHP = 100;
+	Block.CurrentHP = 100;
+	Block.DEF = 10;
+	Block.Resistances[static_cast<uint8>(EElementalAttribute::FIRE)] = 50;
+	UC_AComp_Stats* Stats = NewObject<UC_AComp_Stats>();
+	Stats->ImportStats(Block);
+
+	// Hits are compared by the damage they deal after the victim's defense and resistances, not by their ATK.
+	const FDamageRecord Hits[] = {
+		MakeHit(20, 1.0f, EElementalAttribute::NEUTRAL),	// 10
+		MakeHit(40, 1.0f, EElementalAttribute::FIRE),		// 15, resisted
+		MakeHit(27, 1.0f, EElementalAttribute::NEUTRAL),	// 17
+		MakeHit(255, 1.0f, EElementalAttribute::NON_LETHAL)	// 0
+	};
+	TestEqual(TEXT("Strongest after defense and resistances"), UC_WS_DamageQueue::FindStrongestHit(Hits, Stats), 2);
+
+	const FDamageRecord Multiplied[] = {
+		MakeHit(20, 1.0f, EElementalAttribute::NEUTRAL),	// 10
+		MakeHit(16, 2.5f, EElementalAttribute::NEUTRAL)		// 15
+	};
+	TestEqual(TEXT("Multipliers count"), UC_WS_DamageQueue::FindStrongestHit(Multiplied, Stats), 1);
+
+	const FDamageRecord Tied[] = {
+		MakeHit(20, 1.0f, EElementalAttribute::NEUTRAL),
+		MakeHit(20, 1.0f, EElementalAttribute::NEUTRAL)
+	};
+	TestEqual(TEXT("Ties keep the first hit"), UC_WS_DamageQueue::FindStrongestHit(Tied, Stats), 0);
+
+	TestEqual(TEXT("Victims without stats keep the first hit"), UC_WS_DamageQueue::FindStrongestHit(Hits, nullptr), 0);
+	TestEqual(TEXT("No hits"), UC_WS_DamageQueue::FindStrongestHit({}, Stats), INDEX_NONE);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,233 @@
+// The original code and content of this project is dedicated to the showcase of my (Ricardo Sánchez Villegas)
+// programming skills in Unreal Engine under the MIT Licence.
+// While others may use the provided code and content for their own projects, proper credit is required and appreciated.
+
+
+#include "C_SaveFile.h"
+#include "C_StructsAndEnums.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SaveFileTests
+{
+	// Save Data touching every section: progress spanning more than one completion word, stats and slot values.
+	FSaveData MakeSaveData()
+	{
+		FSaveData SaveData;
+		SaveData.Challenges.Set(SaveData.Challenges.Intern(TEXT("Challenge_A")), true);
+		SaveData.Challenges.Intern(TEXT("Challenge_B"));
+		SaveData.DialogueTriggers.Set(SaveData.DialogueTriggers.Intern(TEXT("Dialogue_A")), true);
+		for (int32 Cutscene = 0; Cutscene < 40; ++Cutscene)
+		{
+			const int32 Index = SaveData.Cutscenes.Intern(FName(TEXT("Cutscene"), Cutscene));
+			SaveData.Cutscenes.Set(Index, Cutscene % 3 == 0);
+		}
+
+		SaveData.PlayerStats.Level = 7;
+		SaveData.PlayerStats.CurrentEXP = 650;
+		SaveData.PlayerStats.MaxHP = 120;
+		SaveData.PlayerStats.CurrentHP = 95;
+		SaveData.PlayerStats.ATK = 31;
+		SaveData.PlayerStats.DEF = 18;
+		SaveData.PlayerStats.Resistances[static_cast<uint8>(EElementalAttribute::FIRE)] = 20;
+		SaveData.PlayTime = 1234.5;
+		SaveData.LastZone = TEXT("Zone_Forest");
+		SaveData.JournalSequence = 42;
+		return SaveData;
+	}
+
+	// Compares the IDs and completion of two sets of flags.
+	void TestFlagsEqual(FAutomationTestBase& Test, const TCHAR* What, const FProgressFlags& Actual,
+		const FProgressFlags& Expected)
+	{
+		Test.TestEqual(*FString::Printf(TEXT("%s IDs"), What), Actual.IDs, Expected.IDs);
+		Test.TestEqual(*FString::Printf(TEXT("%s completion"), What), Actual.CompletionBits, Expected.CompletionBits);
+	}
+
+	// Temporary file of a test, removed before it starts.
+	FString MakeTestPath(const TCHAR* Name)
+	{
+		const FString Path = FPaths::Combine(FPaths::AutomationTransientDir(), Name);
+		IFileManager::Get().Delete(*Path, false, false, true);
+		return Path;
+	}
+
+	// Writes journal records the way the Game Manager buffers them.
+	TArray<uint8> WriteRecords(TConstArrayView<FSaveJournalRecord> Records)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		for (const FSaveJournalRecord& Record : Records)
+		{
+			TOASSaveFile::WriteJournalRecord(Writer, Record);
+		}
+		return Bytes;
+	}
+
+	FSaveJournalRecord MakeRecord(const uint32 Sequence, const EProgressCategory Category, const FName ID,
+		const bool bCompleted)
+	{
+		FSaveJournalRecord Record;
+		Record.Sequence = Sequence;
+		Record.Category = Category;
+		Record.ID = ID;
+		Record.bCompleted = bCompleted;
+		return Record;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveFileRoundTripTest, "TOAS.SaveFile.RoundTrip",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSaveFileRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FSaveData Saved = SaveFileTests::MakeSaveData();
+	const FString Path = SaveFileTests::MakeTestPath(TEXT("RoundTrip.toassave"));
+
+	// Written and loaded through the same path the game uses, including the memory-mapped view.
+	FSaveData Loaded;
+	if (TestTrue(TEXT("Write"), TOASSaveFile::WriteAtomically(Path, TOASSaveFile::Encode(Saved))) == false
+		|| TestTrue(TEXT("Load"), TOASSaveFile::Load(Path, Loaded)) == false)
+	{
+		return false;
+	}
+
+	SaveFileTests::TestFlagsEqual(*this, TEXT("Challenges"), Loaded.Challenges, Saved.Challenges);
+	SaveFileTests::TestFlagsEqual(*this, TEXT("Dialogue Triggers"), Loaded.DialogueTriggers, Saved.DialogueTriggers);
+	SaveFileTests::TestFlagsEqual(*this, TEXT("Cutscenes"), Loaded.Cutscenes, Saved.Cutscenes);
+	TestEqual(TEXT("Lookup after loading"), Loaded.Cutscenes.Find(FName(TEXT("Cutscene"), 33)), 33);
+
+	TestEqual(TEXT("Level"), Loaded.PlayerStats.Level, Saved.PlayerStats.Level);
+	TestEqual(TEXT("Current EXP"), Loaded.PlayerStats.CurrentEXP, Saved.PlayerStats.CurrentEXP);
+	TestEqual(TEXT("Max HP"), Loaded.PlayerStats.MaxHP, Saved.PlayerStats.MaxHP);
+	TestEqual(TEXT("Current HP"), Loaded.PlayerStats.CurrentHP, Saved.PlayerStats.CurrentHP);
+	TestEqual(TEXT("ATK"), Loaded.PlayerStats.ATK, Saved.PlayerStats.ATK);
+	TestEqual(TEXT("DEF"), Loaded.PlayerStats.DEF, Saved.PlayerStats.DEF);
+	TestEqual(TEXT("Fire Resistance"), Loaded.PlayerStats.Resistances[static_cast<uint8>(EElementalAttribute::FIRE)],
+		Saved.PlayerStats.Resistances[static_cast<uint8>(EElementalAttribute::FIRE)]);
+	TestEqual(TEXT("Play Time"), Loaded.PlayTime, Saved.PlayTime);
+	TestEqual(TEXT("Last Zone"), Loaded.LastZone, Saved.LastZone);
+	TestEqual(TEXT("Journal Sequence"), Loaded.JournalSequence, Saved.JournalSequence);
+
+	IFileManager::Get().Delete(*Path, false, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveFileRejectsDamageTest, "TOAS.SaveFile.RejectsDamagedFiles",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSaveFileRejectsDamageTest::RunTest(const FString& Parameters)
+{
+	const TArray<uint8> Bytes = TOASSaveFile::Encode(SaveFileTests::MakeSaveData());
+	FSaveData Decoded;
+	if (TestTrue(TEXT("Intact file"), TOASSaveFile::Decode(Bytes, Decoded)) == false)
+	{
+		return false;
+	}
+
+	// The last byte belongs to the last section, so only its checksum catches the change.
+	TArray<uint8> Section = Bytes;
+	Section.Last() ^= 0xFF;
+	TestFalse(TEXT("Damaged section"), TOASSaveFile::Decode(Section, Decoded));
+
+	// Right after the 16-byte header comes the section table.
+	TArray<uint8> Table = Bytes;
+	Table[16] ^= 0xFF;
+	TestFalse(TEXT("Damaged section table"), TOASSaveFile::Decode(Table, Decoded));
+
+	TArray<uint8> Truncated = Bytes;
+	Truncated.SetNum(Bytes.Num() - 4);
+	TestFalse(TEXT("Truncated file"), TOASSaveFile::Decode(Truncated, Decoded));
+
+	// The version follows the magic.
+	TArray<uint8> OtherVersion = Bytes;
+	OtherVersion[4] = 2;
+	TestFalse(TEXT("Other version"), TOASSaveFile::Decode(OtherVersion, Decoded));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveFileDuplicateIDsTest, "TOAS.SaveFile.RemovesDuplicateIDs",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSaveFileDuplicateIDsTest::RunTest(const FString& Parameters)
+{
+	// A save edited by hand, repeating Challenge_A with only the repeated copy completed.
+	FSaveData Edited;
+	Edited.Challenges.IDs = {TEXT("Challenge_A"), TEXT("Challenge_B"), TEXT("Challenge_A")};
+	Edited.Challenges.CompletionBits = {1u << 2};
+	Edited.Challenges.MarkIDsChanged();
+
+	FSaveData Decoded;
+	if (TestTrue(TEXT("Decode"), TOASSaveFile::Decode(TOASSaveFile::Encode(Edited), Decoded)) == false)
+	{
+		return false;
+	}
+
+	const FProgressFlags& Challenges = Decoded.Challenges;
+	TestEqual(TEXT("IDs"), Challenges.IDs, TArray<FName>{TEXT("Challenge_A"), TEXT("Challenge_B")});
+	TestEqual(TEXT("Index of Challenge_A"), Challenges.Find(TEXT("Challenge_A")), 0);
+	TestTrue(TEXT("Challenge_A keeps the completion of its copy"), Challenges.IsSet(0));
+	TestFalse(TEXT("Challenge_B"), Challenges.IsSet(1));
+	TestEqual(TEXT("Completion words"), Challenges.CompletionBits, TArray<uint32>{1u});
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveFileJournalTest, "TOAS.SaveFile.Journal",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSaveFileJournalTest::RunTest(const FString& Parameters)
+{
+	using SaveFileTests::MakeRecord;
+
+	const FString Path = SaveFileTests::MakeTestPath(TEXT("Journal.toassave.journal"));
+	const FSaveJournalRecord Records[] = {
+		MakeRecord(1, EProgressCategory::CHALLENGE, TEXT("Challenge_A"), true),
+		MakeRecord(2, EProgressCategory::CUTSCENE, TEXT("Cutscene_New"), true),
+		MakeRecord(3, EProgressCategory::CHALLENGE, TEXT("Challenge_B"), true)
+	};
+	if (TestTrue(TEXT("Append"), TOASSaveFile::AppendToFile(Path, SaveFileTests::WriteRecords(Records))) == false)
+	{
+		return false;
+	}
+
+	// The first record is already included in the save, and the new cutscene isn't interned in it yet.
+	FSaveData SaveData;
+	SaveData.Challenges.Intern(TEXT("Challenge_A"));
+	SaveData.Challenges.Intern(TEXT("Challenge_B"));
+	SaveData.JournalSequence = 1;
+
+	TestEqual(TEXT("Replayed up to"), TOASSaveFile::ReplayJournal(Path, SaveData), 3u);
+	TestFalse(TEXT("Records in the save are skipped"),
+		SaveData.Challenges.IsSet(SaveData.Challenges.Find(TEXT("Challenge_A"))));
+	TestTrue(TEXT("Replaying interns new IDs"), SaveData.Cutscenes.IsSet(SaveData.Cutscenes.Find(TEXT("Cutscene_New"))));
+	TestTrue(TEXT("Challenge_B"), SaveData.Challenges.IsSet(SaveData.Challenges.Find(TEXT("Challenge_B"))));
+
+	// A record cut short by the game stopping mid-write ends the replay without failing it.
+	TArray<uint8> CutShort = SaveFileTests::WriteRecords({MakeRecord(4, EProgressCategory::DIALOGUE,
+		TEXT("Dialogue_A"), true)});
+	CutShort.SetNum(CutShort.Num() - 2);
+	TOASSaveFile::AppendToFile(Path, CutShort);
+
+	FSaveData Fresh;
+	TestEqual(TEXT("Cut short record"), TOASSaveFile::ReplayJournal(Path, Fresh), 3u);
+	TestEqual(TEXT("Cut short record is ignored"), Fresh.DialogueTriggers.Find(TEXT("Dialogue_A")), INDEX_NONE);
+
+	// Compacting keeps the records newer than the save, and removes the journal once none are left.
+	TestTrue(TEXT("Compact"), TOASSaveFile::CompactJournal(Path, 2));
+	FSaveData Compacted;
+	TestEqual(TEXT("Kept records"), TOASSaveFile::ReplayJournal(Path, Compacted), 3u);
+	TestEqual(TEXT("Dropped record"), Compacted.Cutscenes.Find(TEXT("Cutscene_New")), INDEX_NONE);
+
+	TestTrue(TEXT("Compact everything"), TOASSaveFile::CompactJournal(Path, 3));
+	TestFalse(TEXT("Journal removed"), IFileManager::Get().FileExists(*Path));
+
+	return true;
+}
+
+#endif